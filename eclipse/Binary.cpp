@@ -0,0 +1,265 @@
+#include "Binary.h"
+
+#include <util/crc16.h>
+
+namespace Binary {
+namespace {
+using Parser::CommandType;
+
+// Type, the longest payload (settime's text) and the CRC, plus COBS's one
+// byte of overhead, all fit in a frame. It also keeps every COBS run
+// under 254 bytes, so no run ever needs splitting.
+static_assert(1 + (Parser::dataSize - 1) + 2 + 1 <= maxFrame && maxFrame < 254,
+              "A full command must fit one frame, and COBS one block");
+
+bool active {false};
+
+uint8_t frame[maxFrame];
+size_t length {0};
+bool dropping {false};  // The current frame is too long; skip to its delimiter
+
+unsigned int goodFrames {0};
+unsigned int badFrames {0};
+
+enum class Layout {
+    Empty,
+    Longs,  // Two int32
+    Floats,  // Two float
+    Byte,
+    Text,
+};
+
+Layout layoutOf(CommandType type) {
+    switch (type) {
+        case CommandType::GoStep:
+        case CommandType::ShiftStep:
+        return Layout::Longs;
+
+        case CommandType::GoInch:
+        case CommandType::ShiftInch:
+        case CommandType::Go:
+        case CommandType::Velocity:
+        case CommandType::HardZero:
+        case CommandType::SoftZero:
+        case CommandType::Drift:
+        return Layout::Floats;
+
+        case CommandType::Test:
+        case CommandType::Binary:
+        case CommandType::Stream:
+        case CommandType::Ack:
+        case CommandType::Nack:
+        case CommandType::Credit:
+        case CommandType::Play:
+        return Layout::Byte;
+
+        case CommandType::SetTime:
+        case CommandType::Viewer:
+        return Layout::Text;
+
+        default:
+        return Layout::Empty;
+    }
+}
+
+// CRC-16/CCITT-FALSE: polynomial 0x1021, starting from 0xFFFF
+uint16_t crc(const uint8_t* bytes, size_t count) {
+    uint16_t out = 0xFFFF;
+    for (size_t i = 0; i < count; i++) {
+        out = _crc_xmodem_update(out, bytes[i]);
+    }
+    return out;
+}
+
+// Each zero is replaced by the distance to the next one, and the first
+// byte holds the distance to the first, so the output has no zeros.
+size_t cobsEncode(const uint8_t* in, size_t count, uint8_t* out) {
+    size_t code = 0;  // Where the current run's length goes
+    size_t written = 1;
+    uint8_t run = 1;
+    for (size_t i = 0; i < count; i++) {
+        if (in[i] == 0) {
+            out[code] = run;
+            code = written++;
+            run = 1;
+        } else {
+            out[written++] = in[i];
+            run++;
+        }
+    }
+    out[code] = run;
+    return written;
+}
+
+// In place, since the output never gets ahead of the input.
+// Returns the decoded length, or -1 if the frame is malformed.
+int cobsDecode(uint8_t* bytes, size_t count) {
+    size_t read = 0;
+    size_t written = 0;
+    while (read < count) {
+        const uint8_t code = bytes[read++];
+        if (code == 0 || read + code - 1 > count) {
+            return -1;
+        }
+        for (uint8_t i = 1; i < code; i++) {
+            bytes[written++] = bytes[read++];
+        }
+        if (read < count) {
+            bytes[written++] = 0;
+        }
+    }
+    return written;
+}
+}
+
+bool enabled() {
+    return active;
+}
+
+void setEnabled(bool enabled) {
+    active = enabled;
+    length = 0;
+    dropping = false;
+}
+
+bool decode(uint8_t* bytes, size_t count, Parser::Command& command) {
+    const int size = cobsDecode(bytes, count);
+    if (size < 3) {
+        return false;
+    }
+    const uint16_t expected = bytes[size - 2] | (bytes[size - 1] << 8);
+    if (crc(bytes, size - 2) != expected) {
+        return false;
+    }
+
+    const auto type = static_cast<CommandType>(bytes[0]);
+    const uint8_t* payload = bytes + 1;
+    const size_t payloadSize = size - 3;
+    switch (layoutOf(type)) {
+        case Layout::Longs: {
+            int32_t values[2];
+            if (payloadSize != sizeof(values)) {
+                return false;
+            }
+            memcpy(values, payload, sizeof(values));
+            command = Parser::Command(type, "", values[0], values[1]);
+            return true;
+        }
+
+        case Layout::Floats: {
+            float values[2];
+            if (payloadSize != sizeof(values)) {
+                return false;
+            }
+            memcpy(values, payload, sizeof(values));
+            command = Parser::Command(type, "", values[0], values[1]);
+            return true;
+        }
+
+        case Layout::Byte:
+        if (payloadSize != 1) {
+            return false;
+        }
+        command = Parser::Command(type, "", payload[0], 0);
+        return true;
+
+        case Layout::Text: {
+            char text[Parser::dataSize];
+            if (payloadSize >= sizeof(text)) {
+                return false;
+            }
+            memcpy(text, payload, payloadSize);
+            text[payloadSize] = '\0';
+            command = Parser::Command(type, text, 0, 0);
+            return true;
+        }
+
+        default:
+        if (payloadSize != 0) {
+            return false;
+        }
+        command = Parser::Command(type, "", 0, 0);
+        return true;
+    }
+}
+
+size_t encode(const Parser::Command& command, uint8_t* out) {
+    uint8_t raw[maxFrame];
+    size_t size = 0;
+    raw[size++] = static_cast<uint8_t>(command.type);
+
+    switch (layoutOf(command.type)) {
+        case Layout::Longs: {
+            const int32_t values[2] {lround(command.num1), lround(command.num2)};
+            memcpy(raw + size, values, sizeof(values));
+            size += sizeof(values);
+            break;
+        }
+
+        case Layout::Floats: {
+            const float values[2] {static_cast<float>(command.num1), static_cast<float>(command.num2)};
+            memcpy(raw + size, values, sizeof(values));
+            size += sizeof(values);
+            break;
+        }
+
+        case Layout::Byte:
+        raw[size++] = static_cast<uint8_t>(command.num1);
+        break;
+
+        case Layout::Text: {
+            const size_t textSize = strlen(command.data);
+            memcpy(raw + size, command.data, textSize);
+            size += textSize;
+            break;
+        }
+
+        default:
+        break;
+    }
+
+    const uint16_t check = crc(raw, size);
+    raw[size++] = check & 0xFF;
+    raw[size++] = check >> 8;
+
+    const size_t written = cobsEncode(raw, size, out);
+    out[written] = 0;
+    return written + 1;
+}
+
+bool poll(Parser::Command& command) {
+    for (int waiting = Serial.available(); waiting > 0; waiting--) {
+        const uint8_t byte = Serial.read();
+        if (byte != 0) {
+            if (length < maxFrame) {
+                frame[length++] = byte;
+            } else {
+                dropping = true;
+            }
+            continue;
+        }
+
+        const bool wasDropping = dropping;
+        const size_t size = length;
+        length = 0;
+        dropping = false;
+        if (size == 0) {
+            continue;  // A lone delimiter, e.g. sent to resynchronize
+        }
+        if (wasDropping || !decode(frame, size, command)) {
+            badFrames++;
+            continue;
+        }
+        goodFrames++;
+        return true;
+    }
+    return false;
+}
+
+void printStatus() {
+    Serial.print("Binary frames (good/bad): ");
+    Serial.print(goodFrames);
+    Serial.print(" / ");
+    Serial.println(badFrames);
+}
+}
@@ -0,0 +1,59 @@
+#ifndef Binary_h
+#define Binary_h
+
+#include <Arduino.h>
+#include "Parser.h"
+
+// Framed binary commands, an alternative to the text lines for hosts that
+// stream a lot of them. Switch over with `binary 1`, and back with the
+// same command sent as a frame with 0.
+//
+// A frame is COBS-encoded so that 0 only ever appears as its delimiter:
+//     COBS(type, payload..., crc low, crc high) 0
+// The type is the CommandType's value, and the CRC is CRC-16/CCITT-FALSE
+// over the type and payload. Payloads are little-endian and fixed per type:
+//     gostep, step              int32 left, int32 right
+//     goinch, inch, go, vel,    float first, float second
+//       origin, fix, drift
+//     test, binary, stream,     uint8
+//       play
+//     ok, no, credit (replies)  uint8
+//     settime, viewer           the text, up to Parser::dataSize - 1 bytes
+//     anything else             nothing
+// py/binary_link.py is the host side.
+namespace Binary {
+
+// Longest encoded frame, without its delimiter
+constexpr size_t maxFrame {32};
+
+bool enabled();
+
+void setEnabled(bool enabled);
+
+/**
+ * @brief Take whatever bytes have already arrived, without waiting.
+ *
+ * @return true once a whole frame has checked out and been unpacked into
+ * command.
+ */
+bool poll(Parser::Command& command);
+
+/**
+ * @brief The device's own encoder, for the loopback test.
+ *
+ * @param out room for maxFrame + 1 bytes
+ * @return bytes written, including the delimiter
+ */
+size_t encode(const Parser::Command& command, uint8_t* out);
+
+/**
+ * @brief Unpack one encoded frame (without its delimiter) in place.
+ *
+ * @return false on bad COBS, a CRC mismatch, or a payload of the wrong size.
+ */
+bool decode(uint8_t* frame, size_t length, Parser::Command& command);
+
+void printStatus();
+}
+
+#endif
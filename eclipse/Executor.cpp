@@ -1,8 +1,14 @@
 #include "Executor.h"
 
+#include "Binary.h"
+#include "LineReader.h"
 #include "Parser.h"
+#include "Program.h"
+#include "RingBuffer.h"
 #include "Scheduler.h"
 #include "MotorSystem.h"
+#include "Test.h"
+#include "Tracker.h"
 
 namespace Executor {
 using namespace Lengths;
@@ -10,37 +16,101 @@ using namespace Lengths;
 namespace {
 
 bool usingScheduled = false;
-constexpr double goSteps {20};
-int goIteration = goSteps;
-TruePosition current{0, 0};
-TruePosition step{0, 0};
-
-void go(TruePosition truePosition) {
-    const Radial radial(truePosition);
-    const Tangential tangential(radial);
-    const TotalLengths lengths(truePosition, radial, tangential);
-    MotorSystem::setBearing(truePosition);
-    MotorSystem::go(lengths);
+
+// Furthest the strings' path may stray from the straight line, in inches.
+constexpr double maxDeviation {0.02};
+constexpr double minPiece {1.0 / 256};  // Fraction of the whole line
+
+TruePosition start{0, 0};
+TruePosition destination{0, 0};
+double done {1};  // Fraction of the line already queued
+double piece {minPiece};  // Fraction to try for the next piece
+TotalLengths reached;  // At the end of what's already queued
+
+// Moves wait here until the planner has room and any line being
+// interpolated is fully queued, so a new command never cuts one short.
+struct Move {
+    Parser::CommandType type;
+    double first;
+    double second;
+};
+RingBuffer<Move, 9> moves;
+
+// While on, every command gets a reply carrying the free slots in moves.
+bool replying {false};
+
+// Commands go into the program instead of being carried out.
+bool recording {false};
+
+bool playing {false};
+uint8_t cursor {0};  // Next step of the program
+uint8_t repeats {0};  // Plays left after this one
+bool looping {false};
+
+TruePosition along(double fraction) {
+    const auto delta = destination - start;
+    return TruePosition(start.x + delta.x * fraction, start.y + delta.y * fraction);
+}
+
+// The table is good enough for judging a chord wherever its error is well
+// inside maxDeviation.
+TotalLengths lengthsAt(TruePosition truePosition) {
+    return lookupLengths(truePosition, maxDeviation / 2);
 }
 
-void go(Position position) {
-    const auto truePosition = TruePosition(position, MotorSystem::originOffset);
-    go(truePosition);
+// How far the middle of the piece strays when both strings move linearly between its ends.
+double deviation(TotalLengths from, TotalLengths to, double middle) {
+    const auto actual = lengthsAt(along(middle));
+    return max(fabs(actual.left - (from.left + to.left) / 2),
+               fabs(actual.right - (from.right + to.right) / 2));
 }
 
 void interpolateGo(Position position) {
-    current = MotorSystem::getTruePosition();
-    const auto destination = TruePosition(position, MotorSystem::originOffset);
-    const auto delta = destination - current;
-    step = TruePosition(delta.x / goSteps, delta.y / goSteps);
-    goIteration = 0;
+    start = MotorSystem::getPlannedTruePosition();
+    destination = TruePosition(position, MotorSystem::originOffset);
+    reached = exactLengths(start);
+    done = 0;
+    piece = 1;
 }
 
+/**
+ * @brief Queue the longest next piece of the line whose chord stays within
+ * maxDeviation, as soon as there's room, so the pieces blend together.
+ *
+ * The chord error grows with the square of the piece, so near the middle of
+ * the workspace one piece often covers the whole move while near the edges
+ * they get shorter.
+ */
 void checkGo() {
-    if (!MotorSystem::stillMoving() && goIteration < goSteps) {
-        current = current + step;
-        goIteration++;
-        go(current);
+    if (done >= 1 || !MotorSystem::canQueue()) {
+        return;
+    }
+
+    double end;
+    double error;
+    TotalLengths lengths;
+    while (true) {
+        end = min(done + piece, 1.0);
+        lengths = lengthsAt(along(end));
+        error = deviation(reached, lengths, (done + end) / 2);
+        if (error <= maxDeviation || piece <= minPiece) {
+            break;
+        }
+        piece /= 2;
+    }
+
+    // The table only judged the chord; the motors go to the exact end, so a
+    // go lands where goinch to the same point would.
+    lengths = exactLengths(along(end));
+    if (!MotorSystem::go(lengths)) {
+        // Nothing past here can be reached along this line either.
+        done = 1;
+        return;
+    }
+    done = end;
+    reached = lengths;
+    if (error < maxDeviation / 4) {
+        piece *= 2;
     }
 }
 
@@ -48,6 +118,7 @@ TotalLengths syncMotors(Tangential tangential) {
     const Radial radial(tangential);
     const TruePosition truePosition(radial);
     const TotalLengths lengths(truePosition, radial, tangential);
+    return lengths;
 }
 
 void softZero(Lengths::Tangential tangential) {
@@ -55,18 +126,78 @@ void softZero(Lengths::Tangential tangential) {
     MotorSystem::zero(lengths);
 }
 
+uint8_t credit() {
+    return moves.capacity() - moves.size();
 }
 
-void execute(Parser::Command command) {
-    // Serial.print("Command entered: ");
-    Serial.println(command);
-    double num1 = command.num1;
-    double num2 = command.num2;
+// Text would get in the way of the host's replies, or of its frames.
+bool quiet() {
+    return replying || Binary::enabled();
+}
 
-    double pair[2] {num1, num2};
+// Over whichever link is in use, so a binary host never sees text.
+void reply(Parser::CommandType type) {
+    if (Binary::enabled()) {
+        uint8_t frame[Binary::maxFrame + 1];
+        const size_t size = Binary::encode(Parser::Command(type, "", credit(), 0), frame);
+        Serial.write(frame, size);
+        return;
+    }
 
-    switch (command.type) {
+    switch (type) {
+        case Parser::CommandType::Ack:
+        Serial.print("ok ");
+        break;
+
+        case Parser::CommandType::Nack:
+        Serial.print("no ");
+        break;
+
+        default:
+        Serial.print("credit ");
+        break;
+    }
+    Serial.println(credit());
+}
+
+bool isMove(Parser::CommandType type) {
+    switch (type) {
+        case Parser::CommandType::ShiftStep:
+        case Parser::CommandType::ShiftInch:
+        case Parser::CommandType::GoStep:
+        case Parser::CommandType::GoInch:
+        case Parser::CommandType::Go:
+        return true;
+
+        default:
+        return false;
+    }
+}
+
+// A loop is only held back by credit, so one with no moves would run a
+// step on every pass of loop().
+bool programHasMove() {
+    for (uint8_t i = 0; i < Program::size(); i++) {
+        if (isMove(Program::read(i).type)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool queueMove(const Parser::Command& command) {
+    if (!moves.push(Move{command.type, command.num1, command.num2})) {
+        if (!quiet()) {
+            Serial.println("Move dropped: queue full");
+        }
+        return false;
+    }
+    return true;
+}
 
+void startMove(const Move& move) {
+    double pair[2] {move.first, move.second};
+    switch (move.type) {
         case Parser::CommandType::ShiftStep:
         MotorSystem::step(Steps(pair));
         break;
@@ -83,14 +214,55 @@ void execute(Parser::Command command) {
         MotorSystem::go(TotalLengths(pair));  // arbitrary length
         break;
 
+        default:
+        interpolateGo(Lengths::Position(pair));
+        break;
+    }
+}
+
+void feedMoves() {
+    Move move;
+    while (done >= 1 && MotorSystem::canQueue() && moves.pop(move)) {
+        startMove(move);
+        if (replying) {
+            reply(Parser::CommandType::Credit);
+        }
+    }
+}
+
+void dropMoves() {
+    moves.clear();
+    done = 1;
+    playing = false;
+}
+
+bool carryOut(const Parser::Command& command) {
+    double num1 = command.num1;
+    double num2 = command.num2;
+
+    double pair[2] {num1, num2};
+    bool accepted = true;
+
+    switch (command.type) {
+
+        case Parser::CommandType::ShiftStep:
+        case Parser::CommandType::ShiftInch:
+        case Parser::CommandType::GoStep:
+        case Parser::CommandType::GoInch:
+        case Parser::CommandType::Go:
+        accepted = queueMove(command);
+        break;
+
         case Parser::CommandType::GetStep:
         // Note that this is very raw.
-        Serial.println(MotorSystem::getSteps());
+        printTo(Serial, MotorSystem::getSteps());
+        Serial.println();
         break;
 
         case Parser::CommandType::GetInch:
         // Note that this DOES include the arc
-        Serial.println(MotorSystem::getTangential());
+        printTo(Serial, MotorSystem::getTangential());
+        Serial.println();
         break;
 
         case Parser::CommandType::SoftZero:
@@ -102,12 +274,14 @@ void execute(Parser::Command command) {
         Serial.println("Hardzero unavailable");
         break;
 
-        case Parser::CommandType::Go:
-        go(Lengths::Position(pair));
+        case Parser::CommandType::Velocity:
+        dropMoves();
+        MotorSystem::setVelocity(GridSpeed(pair));
         break;
 
         case Parser::CommandType::GetPosition:
-        Serial.println(MotorSystem::getPosition());
+        printTo(Serial, MotorSystem::getPosition());
+        Serial.println();
         break;
 
         case Parser::CommandType::SetTime:
@@ -115,21 +289,145 @@ void execute(Parser::Command command) {
         break;
 
         case Parser::CommandType::Stop:
-        MotorSystem::step(TotalLengths(0, 0));
+        dropMoves();
+        MotorSystem::stop();
+        break;
+
+        case Parser::CommandType::Status:
+        MotorSystem::printStatus();
+        LineReader::printStatus();
+        Binary::printStatus();
+        Tracker::printStatus();
+        break;
+
+        case Parser::CommandType::Test:
+        Test::run(static_cast<int>(command.num1));
+        break;
+
+        case Parser::CommandType::Binary:
+        Binary::setEnabled(command.num1 != 0);
+        MotorSystem::setQuiet(quiet());
+        break;
+
+        case Parser::CommandType::Stream:
+        replying = command.num1 != 0;
+        MotorSystem::setQuiet(quiet());
         break;
 
         case Parser::CommandType::Start:
         usingScheduled = true;
+        Tracker::catchUp();  // Rather than a whole interval after boot
         break;
 
         case Parser::CommandType::Pause:
         usingScheduled = false;
         break;
 
+        case Parser::CommandType::Viewer:
+        accepted = Tracker::setViewer(command.data);
+        if (!accepted && !quiet()) {
+            Serial.println("Bad viewer");
+        }
+        break;
+
+        case Parser::CommandType::Drift:
+        Tracker::setTolerance(num1);
+        break;
+
+        case Parser::CommandType::Record:
+        dropMoves();
+        Program::begin();
+        recording = true;
+        break;
+
+        case Parser::CommandType::EndRecord:
+        if (recording) {
+            Program::finish();
+            recording = false;
+        }
+        break;
+
+        case Parser::CommandType::Play:
+        if (Program::size() == 0 || (num1 == 0 && !programHasMove())) {
+            if (Program::size() && !quiet()) {
+                Serial.println("Can't loop a program without moves");
+            }
+            accepted = false;
+            break;
+        }
+        looping = num1 == 0;
+        repeats = num1 >= 1 ? min(num1, 255.0) - 1 : 0;
+        cursor = 0;
+        playing = true;
+        break;
+
         default:
-        Serial.println("Bad command");
+        if (!quiet()) {
+            Serial.println("Bad command");
+        }
+        accepted = false;
         break;
     }
+    return accepted;
+}
+
+// The scheduler's and the program's commands weren't sent by the host, so
+// they get no ok or no; a credit reply tells it of any slot they took.
+void carryOutOwn(const Parser::Command& command) {
+    const uint8_t before = credit();
+    carryOut(command);
+    if (replying && credit() != before) {
+        reply(Parser::CommandType::Credit);
+    }
+}
+
+/**
+ * @brief Carry out the program's next step, at most one per pass, and only
+ * once there's room for it in moves, so a long program trickles in behind
+ * the motion instead of overflowing the queue.
+ *
+ */
+void playProgram() {
+    if (!playing || credit() == 0) {
+        return;
+    }
+
+    if (cursor >= Program::size()) {
+        if (!looping && repeats == 0) {
+            playing = false;
+            return;
+        }
+        if (!looping) {
+            repeats--;
+        }
+        cursor = 0;
+    }
+    carryOutOwn(Program::read(cursor++));
+}
+
+}
+
+void execute(Parser::Command command) {
+    // Serial.print("Command entered: ");
+    if (!quiet()) {
+        Serial.println(command);
+    }
+
+    bool accepted;
+    // Stop still acts at once, so a runaway can be halted mid-recording.
+    if (recording && command.type != Parser::CommandType::EndRecord
+        && command.type != Parser::CommandType::Stop) {
+        accepted = Program::append(command);
+        if (!accepted && !quiet()) {
+            Serial.println("Can't record that");
+        }
+    } else {
+        accepted = carryOut(command);
+    }
+
+    if (replying) {
+        reply(accepted ? Parser::CommandType::Ack : Parser::CommandType::Nack);
+    }
 }
 
 void init(Tangential tangential) {
@@ -137,24 +435,53 @@ void init(Tangential tangential) {
     const String startTime = "1970.01.01 05:00";
     constexpr double startZone = -5;
     constexpr double rate = 1;
-    constexpr double interval = 1;
 
     Scheduler::init(startTime, rate);
     Scheduler::setZone(startZone);
-    Scheduler::setInterval(interval);
+    Tracker::init();
 
     MotorSystem::init(tangential);
 }
 
+void executeLine(char* line) {
+    while (line) {
+        char* next = strchr(line, ';');
+        if (next) {
+            *next++ = '\0';
+        }
+        while (*line == ' ') {
+            line++;
+        }
+        if (*line) {
+            if (!quiet()) {
+                Serial.print("Entered: ");
+            }
+            execute(Parser::parse(line));
+        }
+        line = next;
+    }
+}
+
+bool streaming() {
+    return replying;
+}
+
 void run() {
     Scheduler::run();
     MotorSystem::run();
     checkGo();
+    feedMoves();
+    playProgram();
     
     if (Scheduler::ready && usingScheduled) {
         auto command = Scheduler::fetch();
-        Serial.print("Scheduled: ");
-        execute(command);
+        if (command.type != Parser::CommandType::Invalid) {
+            if (!quiet()) {
+                Serial.print("Scheduled: ");
+                Serial.println(command);
+            }
+            carryOutOwn(command);
+        }
     }
 }
 
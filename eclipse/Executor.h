@@ -10,7 +10,26 @@ void init(Lengths::Tangential tangential);
 
 void run();
 
+/**
+ * @brief Carry out a command. Moves are queued behind the ones already
+ * waiting rather than replacing them.
+ * 
+ */
 void execute(Parser::Command command);
+
+/**
+ * @brief Parse and execute each of the semicolon separated commands in a
+ * line, in order, as though they had come one per line. Modifies the line.
+ * 
+ */
+void executeLine(char* line);
+
+/**
+ * @brief Whether commands are being answered with the move queue's credit
+ * (see Parser::CommandType::Stream), in which case nothing else is echoed.
+ * 
+ */
+bool streaming();
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "Fixed.h"
+
+#include <avr/pgmspace.h>
+
+namespace {
+// atan(i / tableSteps) for i = 0..tableSteps, in 1/65536ths of a radian.
+// Linear interpolation between entries is off by at most 2e-5 rad.
+constexpr uint8_t tableSteps {64};
+const uint16_t atanTable[tableSteps + 1] PROGMEM {
+    0, 1024, 2047, 3070, 4091, 5110, 6126, 7140,
+    8150, 9156, 10158, 11155, 12147, 13133, 14114, 15088,
+    16055, 17015, 17968, 18913, 19850, 20779, 21699, 22610,
+    23512, 24406, 25289, 26163, 27028, 27882, 28727, 29561,
+    30386, 31200, 32003, 32797, 33580, 34353, 35115, 35867,
+    36608, 37340, 38060, 38771, 39472, 40162, 40842, 41512,
+    42172, 42823, 43464, 44095, 44716, 45328, 45931, 46525,
+    47109, 47685, 48251, 48809, 49359, 49899, 50432, 50956,
+    51472,
+};
+
+constexpr Fixed halfPi {PI / 2};
+constexpr Fixed unity {1.0};
+
+int32_t readAtan(uint8_t i) {
+    return pgm_read_word(&atanTable[i]);
+}
+}
+
+Fixed sqrt(Fixed value) {
+    if (value.raw <= 0) {
+        return Fixed();
+    }
+
+    // sqrt(raw / 2^16) * 2^16 is sqrt(raw * 2^16)
+    uint64_t remainder = static_cast<uint64_t>(value.raw) << Fixed::fractionBits;
+    uint64_t root = 0;
+    uint64_t bit = uint64_t(1) << 46;  // Largest power of four below 2^47
+    while (bit > remainder) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (remainder >= root + bit) {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return Fixed::fromRaw(static_cast<int32_t>(root));
+}
+
+Fixed atan(Fixed value) {
+    if (value.raw < 0) {
+        return -atan(-value);
+    }
+    if (value.raw > Fixed::one) {
+        return halfPi - atan(unity / value);
+    }
+
+    const uint32_t scaled = static_cast<uint32_t>(value.raw) * tableSteps;
+    const uint8_t i = scaled >> Fixed::fractionBits;
+    if (i == tableSteps) {
+        return Fixed::fromRaw(readAtan(i));
+    }
+    const int32_t fraction = scaled & (Fixed::one - 1);
+    const int32_t low = readAtan(i);
+    return Fixed::fromRaw(low + (((readAtan(i + 1) - low) * fraction) >> Fixed::fractionBits));
+}
+
+// acos(x) = pi/2 - asin(x), and asin(x) = atan(x / sqrt(1 - x^2))
+Fixed acos(Fixed value) {
+    if (value >= unity) {
+        return Fixed();
+    }
+    if (value <= -unity) {
+        return halfPi + halfPi;
+    }
+    return halfPi - atan(value / sqrt(unity - value * value));
+}
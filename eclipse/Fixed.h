@@ -0,0 +1,97 @@
+#ifndef Fixed_h
+#define Fixed_h
+
+#include <Arduino.h>
+
+/**
+ * @brief Q16.16 fixed point: a 32-bit count of 1/65536ths. Holds +-32767
+ * with a resolution of 1.5e-5, so inches on this rig (a microstep is about
+ * 1.5e-3 in) and their squares both fit.
+ *
+ * Arithmetic is all integer; atan and acos come from a table in flash
+ * (see Fixed.cpp). Doubles convert in implicitly so constants mix freely,
+ * but converting back out has to be asked for.
+ */
+struct Fixed {
+    static constexpr int fractionBits {16};
+    static constexpr int32_t one {int32_t(1) << fractionBits};
+
+    int32_t raw {0};
+
+    constexpr Fixed() = default;
+
+    constexpr Fixed(double value)
+        : raw{static_cast<int32_t>(value * one + (value < 0 ? -0.5 : 0.5))}
+        {}
+
+    static constexpr Fixed fromRaw(int32_t raw) {
+        return Fixed(raw, RawTag{});
+    }
+
+    explicit constexpr operator double() const {
+        return static_cast<double>(raw) / one;
+    }
+
+private:
+    // Tells the raw constructor from the one taking a double
+    struct RawTag {};
+
+    // A single return keeps fromRaw() constexpr under the core's gnu++11.
+    constexpr Fixed(int32_t _raw, RawTag)
+        : raw{_raw}
+        {}
+};
+
+inline constexpr Fixed operator+(Fixed first, Fixed second) {
+    return Fixed::fromRaw(first.raw + second.raw);
+}
+
+inline constexpr Fixed operator-(Fixed first, Fixed second) {
+    return Fixed::fromRaw(first.raw - second.raw);
+}
+
+inline constexpr Fixed operator-(Fixed value) {
+    return Fixed::fromRaw(-value.raw);
+}
+
+inline Fixed operator*(Fixed first, Fixed second) {
+    return Fixed::fromRaw(static_cast<int32_t>((static_cast<int64_t>(first.raw) * second.raw) >> Fixed::fractionBits));
+}
+
+inline Fixed operator/(Fixed first, Fixed second) {
+    return Fixed::fromRaw(static_cast<int32_t>((static_cast<int64_t>(first.raw) << Fixed::fractionBits) / second.raw));
+}
+
+inline constexpr bool operator<(Fixed first, Fixed second) {
+    return first.raw < second.raw;
+}
+
+inline constexpr bool operator>(Fixed first, Fixed second) {
+    return first.raw > second.raw;
+}
+
+inline constexpr bool operator<=(Fixed first, Fixed second) {
+    return first.raw <= second.raw;
+}
+
+inline constexpr bool operator>=(Fixed first, Fixed second) {
+    return first.raw >= second.raw;
+}
+
+inline constexpr bool operator==(Fixed first, Fixed second) {
+    return first.raw == second.raw;
+}
+
+inline constexpr Fixed fabs(Fixed value) {
+    return value.raw < 0 ? -value : value;
+}
+
+// Bit by bit, so exact to the last place. Negative values give 0.
+Fixed sqrt(Fixed value);
+
+// Within about 2e-5 rad.
+Fixed atan(Fixed value);
+
+Fixed acos(Fixed value);
+
+#endif
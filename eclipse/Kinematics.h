@@ -0,0 +1,77 @@
+#ifndef Kinematics_h
+#define Kinematics_h
+
+#include <Arduino.h>
+#include "Fixed.h"
+
+// The trig behind the Lengths conversions, one string at a time, written
+// once for any scalar: double (float on AVR), float or Fixed. Lengths picks
+// one with LENGTHS_SCALAR; the rest are there to compare against.
+namespace Kinematics {
+
+template<class T>
+T hypotenuse(T leg, T altitude) {
+    return sqrt(leg * leg + altitude * altitude);
+}
+
+template<class T>
+T leg(T hypotenuse, T other) {
+    return sqrt(hypotenuse * hypotenuse - other * other);
+}
+
+/**
+ * @brief Free string plus what's wrapped on the spool past the top, for
+ * the blocker `horizontal` across from and `vertical` below the spool.
+ *
+ */
+template<class T>
+T totalLength(T horizontal, T vertical, T radial, T tangential, T radius) {
+    const T verticalAngle = atan(horizontal / vertical);
+    const T tangentRadial = acos(radius / radial);
+    return tangential + radius * (T(PI / 2) - (tangentRadial - verticalAngle));
+}
+
+/**
+ * @brief Heron's formula for the height of the triangle with the two
+ * radials and the motor baseline, split into two square roots so that no
+ * intermediate outgrows Q16.16.
+ *
+ */
+template<class T>
+T offset(T left, T right, T width) {
+    const T semiPerimeter = (left + right + width) / T(2.0);
+    const T area = sqrt(semiPerimeter * (semiPerimeter - width))
+                 * sqrt((semiPerimeter - left) * (semiPerimeter - right));
+    return T(2.0) * area / width;
+}
+
+/**
+ * @brief Total lengths in steps for a whole trajectory at once, from
+ * separate x and y arrays. Points don't depend on each other and there are
+ * no branches, so on x86 GCC vectorizes the loop at -O3 (the atan and acos
+ * need -ffast-math to reach glibc's vector versions).
+ *
+ * The trig runs in T; the scaling to steps is in double whatever T is,
+ * since a step count outgrows Q16.16.
+ */
+template<class T>
+void totalSteps(const double* __restrict x, const double* __restrict y, size_t count,
+                T width, T radius, double stepsPerInch,
+                int32_t* __restrict left, int32_t* __restrict right) {
+    for (size_t i = 0; i < count; i++) {
+        const T across = x[i];
+        const T down = y[i];
+        const T fromRight = width - across;
+        const T leftRadial = hypotenuse(across, down);
+        const T rightRadial = hypotenuse(fromRight, down);
+        const T leftTotal = totalLength(across, down, leftRadial, leg(leftRadial, radius), radius);
+        const T rightTotal = totalLength(fromRight, down, rightRadial, leg(rightRadial, radius), radius);
+
+        // Lengths are positive, so this rounds without lround().
+        left[i] = static_cast<int32_t>(static_cast<double>(leftTotal) * stepsPerInch + 0.5);
+        right[i] = static_cast<int32_t>(static_cast<double>(rightTotal) * stepsPerInch + 0.5);
+    }
+}
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include "Lengths.h"
 
 #include <Arduino.h>
+#include "Kinematics.h"
+#include "WorkspaceTable.h"
 
 namespace Lengths {
 namespace {
@@ -17,11 +19,15 @@ size_t printToPair(Print& p, double first, double second) {
 }
 
 inline double getHypotenuse(double leg, double altitude) {
-    return sqrt(sq(leg) + sq(altitude));
+    return static_cast<double>(Kinematics::hypotenuse<Scalar>(leg, altitude));
 };
 
 inline double getLeg(double hypotenuse, double leg) {
-    return sqrt(sq(hypotenuse) - sq(leg));
+    return static_cast<double>(Kinematics::leg<Scalar>(hypotenuse, leg));
+}
+
+inline double getTotalLength(double horizontal, double vertical, double radial, double tangential) {
+    return static_cast<double>(Kinematics::totalLength<Scalar>(horizontal, vertical, radial, tangential, radius));
 }
 
 template<class T>
@@ -34,8 +40,50 @@ inline T getLegs(double hypotenuse1, double hypotenuse2, double altitude) {
     return T(getLeg(hypotenuse1, altitude), getLeg(hypotenuse2, altitude));
 }
 
+constexpr double inverseTolerance {1e-4};  // inches; a microstep is about 1.5e-3
+
+// Each step linearizes at the estimate and solves the 2x2 system exactly.
+TruePosition solveTruePosition(TotalLengths lengths, TruePosition seed) {
+    TruePosition estimate = seed;
+    inverseIterations = 0;
+    while (inverseIterations < maxIterations) {
+        inverseIterations++;
+        const Jacobian linearization(estimate);
+        const bool converged = linearization.drift(lengths) < inverseTolerance;
+        estimate = linearization.toTruePosition(lengths);
+        if (converged) {
+            break;
+        }
+    }
+    return estimate;
+}
+
+// Index of the table cell holding the position, or -1 outside the table.
+int findCell(TruePosition truePosition, double& across, double& down) {
+    using namespace WorkspaceTable;
+    across = (truePosition.x - xStart) / spacing;
+    down = (truePosition.y - yStart) / spacing;
+    if (!(across >= 0 && down >= 0 && across < columns - 1 && down < rows - 1)) {
+        return -1;
+    }
+    return static_cast<int>(down) * (columns - 1) + static_cast<int>(across);
+}
+
+constexpr bool close(double first, double second) {
+    return first - second < 1e-4 && second - first < 1e-4;
+}
+static_assert(close(WorkspaceTable::rigWidth, width) && close(WorkspaceTable::rigRadius, radius)
+              && close(WorkspaceTable::yStart, minHeight),
+              "WorkspaceTable.h is for another rig; rerun py/workspace_table.py");
+
+double readLength(int node, uint8_t string) {
+    return pgm_read_word(&WorkspaceTable::lengths[node][string]);
+}
+
 }
 
+uint8_t inverseIterations {0};
+
 GridPair::GridPair(double _x, double _y)
     : x{_x}, y{_y}
     {}
@@ -69,6 +117,14 @@ TruePosition::TruePosition(Radial radial)
     : TruePosition(radial, radial.findOffset())
     {}
 
+TruePosition::TruePosition(TotalLengths lengths, TruePosition seed)
+    : TruePosition(solveTruePosition(lengths, seed))
+    {}
+
+TruePosition::TruePosition(TotalLengths lengths)
+    : TruePosition(lengths, TruePosition(Radial(approximateTangential(lengths))))
+    {}
+
 Radial::Radial(TruePosition truePosition)
     : Radial(getHypotenuses<Radial>(truePosition.x, width - truePosition.x, truePosition.y))
     {}
@@ -81,32 +137,20 @@ Tangential::Tangential(Radial radial)
     : Tangential(getLegs<Tangential>(radial.left, radial.right, radius))
     {}
 
-// Approximate until I can find the analytic inverse or a better approximation.
-// Off by at most radius * pi/4 (an eighth of a circle)
-// TODO change from approximate
 Tangential::Tangential(TotalLengths lengths)
-    : Tangential(lengths.left - radius * PI/4, lengths.right - radius * PI/4)
+    : Tangential(Radial(TruePosition(lengths)))
     {}
 
+Tangential approximateTangential(TotalLengths lengths) {
+    return Tangential(lengths.left - radius * PI/4, lengths.right - radius * PI/4);
+}
+
 // Frankly all three of the arguments are able to be gotten from the others, but 
 // we have this because sometimes we convert differently TODO remove?
 TotalLengths::TotalLengths(TruePosition truePosition, Radial radial, Tangential tangential) {
     // y should always be positive
-    const Angle vertical {
-        atan(truePosition.x/truePosition.y),
-        atan((width - truePosition.x)/truePosition.y)
-    };
-
-    // Angle between radial and the radius connected to tangent
-    const double r {Lengths::radius};
-    const Angle tangentRadial {acos(r/radial.left), acos(r/radial.right)};
-    const Angle starter{PI/2, PI/2};
-    const Angle offset = starter - (tangentRadial - vertical);
-
-    const ArcLength arc = offset.toArcLength(r);
-
-    left = tangential.left + arc.left;
-    right = tangential.right + arc.right;
+    left = getTotalLength(truePosition.x, truePosition.y, radial.left, tangential.left);
+    right = getTotalLength(width - truePosition.x, truePosition.y, radial.right, tangential.right);
 }
 
 Steps::Steps(long _left, long _right)
@@ -117,28 +161,102 @@ Steps::Steps(double pair[2])
     : left{lround(pair[0])}, right{lround(pair[1])}
     {}
 
-size_t GridPair::printTo(Print& p) const {
-    return p.print("GridPair: ") + printToPair(p, this->x, this->y);
+size_t printTo(Print& p, const GridPair& pair) {
+    return p.print("GridPair: ") + printToPair(p, pair.x, pair.y);
 }
 
-size_t StringPair::printTo(Print& p) const {
-    return p.print("StringPair: ") + printToPair(p, this->left, this->right);
+size_t printTo(Print& p, const StringPair& pair) {
+    return p.print("StringPair: ") + printToPair(p, pair.left, pair.right);
 }
 
-size_t Steps::printTo(Print& p) const {
-    return p.print("Steps: ") + printToPair(p, this->left, this->right);
+size_t printTo(Print& p, const Steps& steps) {
+    return p.print("Steps: ") + printToPair(p, steps.left, steps.right);
 }
 
 double Radial::findOffset() const {
-    const double semiPerimeter = (left + right + width) / 2;
-    const double area = sqrt(semiPerimeter *
-                        (semiPerimeter - left) *
-                        (semiPerimeter - right) *
-                        (semiPerimeter - width));
-    const double offset = 2 * area / width;
-    return offset;
+    return static_cast<double>(Kinematics::offset<Scalar>(left, right, width));
+}
+
+
+Jacobian::Jacobian(TruePosition truePosition)
+    : at{truePosition} {
+    const Radial radial(truePosition);
+    const Tangential tangential(radial);
+    lengthsAt = TotalLengths(truePosition, radial, tangential);
+
+    // The free string leans off the radial by asin(radius / radial), toward
+    // the spool's far side. Written out, that needs no more trig.
+    const double leftSquared = sq(radial.left);
+    leftX = (truePosition.x * tangential.left + truePosition.y * radius) / leftSquared;
+    leftY = (truePosition.y * tangential.left - truePosition.x * radius) / leftSquared;
+
+    const double fromRight = width - truePosition.x;
+    const double rightSquared = sq(radial.right);
+    rightX = -(fromRight * tangential.right + truePosition.y * radius) / rightSquared;
+    rightY = (truePosition.y * tangential.right - fromRight * radius) / rightSquared;
+}
+
+StringSpeed Jacobian::toStringSpeed(GridSpeed speed) const {
+    return StringSpeed(leftX * speed.x + leftY * speed.y,
+                       rightX * speed.x + rightY * speed.y);
+}
+
+TruePosition Jacobian::toTruePosition(TotalLengths lengths) const {
+    const double left = lengths.left - lengthsAt.left;
+    const double right = lengths.right - lengthsAt.right;
+    const double determinant = leftX * rightY - leftY * rightX;
+    return TruePosition(at.x + (rightY * left - leftY * right) / determinant,
+                        at.y + (leftX * right - rightX * left) / determinant);
+}
+
+double Jacobian::drift(TotalLengths lengths) const {
+    return max(fabs(lengths.left - lengthsAt.left), fabs(lengths.right - lengthsAt.right));
+}
+
+TotalLengths exactLengths(TruePosition truePosition) {
+    const Radial radial(truePosition);
+    const Tangential tangential(radial);
+    return TotalLengths(truePosition, radial, tangential);
 }
 
+TotalLengths lookupLengths(TruePosition truePosition, double tolerance) {
+    using namespace WorkspaceTable;
+    double across;
+    double down;
+    const int cell = findCell(truePosition, across, down);
+    if (cell < 0 || pgm_read_byte(&cellErrors[cell]) > tolerance * unitsPerInch) {
+        return exactLengths(truePosition);
+    }
+
+    const int column = static_cast<int>(across);
+    const int row = static_cast<int>(down);
+    const double fx = across - column;
+    const double fy = down - row;
+    const int node = row * columns + column;
+
+    double out[2];
+    for (uint8_t string = 0; string < 2; string++) {
+        const double top = readLength(node, string) + fx * (readLength(node + 1, string) - readLength(node, string));
+        const double bottom = readLength(node + columns, string)
+                            + fx * (readLength(node + columns + 1, string) - readLength(node + columns, string));
+        out[string] = (top + fy * (bottom - top)) / unitsPerInch;
+    }
+    return TotalLengths(out);
+}
+
+double lookupError(TruePosition truePosition) {
+    double across;
+    double down;
+    const int cell = findCell(truePosition, across, down);
+    if (cell < 0) {
+        return -1;
+    }
+    return pgm_read_byte(&WorkspaceTable::cellErrors[cell]) / WorkspaceTable::unitsPerInch;
+}
+
+void toSteps(const double* x, const double* y, size_t count, int32_t* left, int32_t* right) {
+    Kinematics::totalSteps<Scalar>(x, y, count, width, radius, Rig::Active::stepsPerInch, left, right);
+}
 
 TotalLengths::TotalLengths(Tangential tangential, ArcLength arc) {
     left = tangential.left + arc.left;
@@ -2,20 +2,27 @@
 #define Lengths_h
 
 #include <Arduino.h>
+#include "Rig.h"
+#include "Fixed.h"
 
 namespace Lengths {
 
 // All measurements done in inches from the contact point of the string on the spool.
-constexpr double minHeight {6};  // Limits max torque on spool; minimum permissible vertical displacement
-constexpr double width {41.232};  // Distance at motor level
-
-// Currently unused
-constexpr double height {55};  // Biggest permissible vertical displacement (less than longest string permitted)
-
-constexpr double inchPerRotation {2.37578};
-constexpr double radius {inchPerRotation / (2*PI)};
-
-struct GridPair : public Printable {
+// They belong to the rig being built for; see Rig.h.
+constexpr double minHeight {Rig::Active::minHeight};
+constexpr double width {Rig::Active::width};
+constexpr double height {Rig::Active::height};
+constexpr double inchPerRotation {Rig::Active::inchPerRotation};
+constexpr double radius {Rig::Active::radius};
+
+// What the trig in the conversions runs in: double (float on AVR), float
+// or Fixed, picked with -DLENGTHS_SCALAR=<type>. The pairs still store double.
+#ifndef LENGTHS_SCALAR
+#define LENGTHS_SCALAR double
+#endif
+using Scalar = LENGTHS_SCALAR;
+
+struct GridPair {
     double x;
     double y;
 
@@ -24,11 +31,9 @@ struct GridPair : public Printable {
     GridPair(double pair[2]);
 
     GridPair(double _x, double _y);
-
-    size_t printTo(Print& p) const;
 };
 
-struct StringPair : public Printable {
+struct StringPair {
     double left {0};
     double right {0};
 
@@ -37,8 +42,6 @@ struct StringPair : public Printable {
     StringPair(double pair[2]);
 
     StringPair(double _left, double _right);
-
-    size_t printTo(Print& p) const;
 };
 
 // Hierarchy of most abstract to most concrete
@@ -60,13 +63,23 @@ struct TruePosition : public GridPair {
 
     TruePosition(Position position, double offset);
     TruePosition(Radial radial);
-    // TruePosition(TotalLengths lengths);
+
+    /**
+     * @brief Exact inverse of the wrapped string lengths, by Newton's method
+     * on the Jacobian starting from a nearby pose (usually the last known
+     * one). Stops within a ten-thousandth of an inch or after maxIterations.
+     * 
+     */
+    TruePosition(TotalLengths lengths, TruePosition seed);
+
+    // Seeded from approximateTangential(), which costs an iteration or two more.
+    TruePosition(TotalLengths lengths);
 private:
     TruePosition(Radial radial, double offset);
 };
 
 inline TruePosition operator-(TruePosition first, TruePosition second) {
-    return TruePosition{second.x - first.x, second.y - first.y};
+    return TruePosition{first.x - second.x, first.y - second.y};
 }
 
 inline TruePosition operator+(TruePosition first, TruePosition second) {
@@ -102,9 +115,21 @@ struct Tangential : public StringPair {
 
     Tangential(Radial radial);
     // Tangential(Position position);
-    Tangential(TotalLengths lengths);
+    Tangential(TotalLengths lengths);  // Exact, through TruePosition(TotalLengths)
 };
 
+/**
+ * @brief The old inverse: take an eighth of a spool turn off each string.
+ * Off by up to radius * pi/4, but cheap, so it seeds the exact one.
+ * 
+ */
+Tangential approximateTangential(TotalLengths lengths);
+
+constexpr uint8_t maxIterations {8};
+
+// Newton iterations taken by the last TruePosition(TotalLengths)
+extern uint8_t inverseIterations;
+
 struct ArcLength : public StringPair {
     using StringPair::StringPair;
 };
@@ -134,21 +159,97 @@ struct StringSpeed : public StringPair {
     using StringPair::StringPair;
 };
 
-struct Steps : public Printable {
+/**
+ * @brief How the total string lengths change with the blocker's position,
+ * linearized around one pose so that per-tick updates are a 2x2 product
+ * instead of the whole Radial -> Tangential -> TotalLengths chain.
+ * 
+ * Each row is the unit vector along the free string, from where it leaves
+ * the spool to the blocker, which is exact even with the wrap.
+ */
+struct Jacobian {
+    TruePosition at;
+    TotalLengths lengthsAt;
+
+    // Partial derivatives of each string with respect to x and y
+    double leftX;
+    double leftY;
+    double rightX;
+    double rightY;
+
+    Jacobian(TruePosition truePosition);
+
+    StringSpeed toStringSpeed(GridSpeed speed) const;
+
+    /**
+     * @brief Invert the linearization. Good while the lengths stay close
+     * to lengthsAt; the error grows with the square of the distance.
+     * 
+     */
+    TruePosition toTruePosition(TotalLengths lengths) const;
+
+    /**
+     * @brief The larger change in string length since the linearization,
+     * in inches, to decide when to take a new one.
+     * 
+     */
+    double drift(TotalLengths lengths) const;
+};
+
+/**
+ * @brief Total lengths by the full chain, TruePosition -> Radial ->
+ * Tangential -> TotalLengths.
+ * 
+ */
+TotalLengths exactLengths(TruePosition truePosition);
+
+/**
+ * @brief Total lengths from the table in WorkspaceTable.h, bilinearly
+ * interpolated between the four nodes around the position. Falls back to the
+ * exact chain outside the table or where the cell's worst error is over
+ * tolerance (in inches).
+ * 
+ */
+TotalLengths lookupLengths(TruePosition truePosition, double tolerance);
+
+/**
+ * @brief Absolute step counts for a whole trajectory of true positions,
+ * the batch form of the usual TruePosition -> TotalLengths chain, for
+ * planning many points at once. See Kinematics::totalSteps().
+ * 
+ */
+void toSteps(const double* x, const double* y, size_t count, int32_t* left, int32_t* right);
+
+// Worst interpolation error of the cell holding the position, in inches; negative outside the table.
+double lookupError(TruePosition truePosition);
+
+struct Steps {
     long left {0};
     long right {0};
 
     Steps() = default;
     Steps(double pair[2]);
     Steps(long _left, long _right); 
-
-    size_t printTo(Print& p) const;
 };
 
+// Plain values with no vtable, so they copy as bytes and pack tightly into queues.
+static_assert(__is_trivially_copyable(TruePosition) && sizeof(TruePosition) == 2 * sizeof(double), "Pair types must stay plain pairs");
+static_assert(__is_trivially_copyable(TotalLengths) && sizeof(TotalLengths) == 2 * sizeof(double), "Pair types must stay plain pairs");
+static_assert(__is_trivially_copyable(Steps) && sizeof(Steps) == 2 * sizeof(long), "Pair types must stay plain pairs");
+
+// Printing, e.g. "Steps: (10, 20)"
+size_t printTo(Print& p, const GridPair& pair);
+size_t printTo(Print& p, const StringPair& pair);
+size_t printTo(Print& p, const Steps& steps);
+
 inline Steps operator-(Steps first, Steps second) {
     return Steps(first.left - second.left, first.right - second.right);
 }
 
+inline Steps operator+(Steps first, Steps second) {
+    return Steps(first.left + second.left, first.right + second.right);
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "LineReader.h"
+
+namespace LineReader {
+namespace {
+char line[lineSize];
+size_t length {0};
+bool dropping {false};  // The current line is too long; skip to its end
+
+unsigned int droppedCount {0};
+unsigned int overflowCount {0};
+
+// HardwareSerial holds one byte less than its buffer.
+constexpr int receiveCapacity {SERIAL_RX_BUFFER_SIZE - 1};
+}
+
+char* poll() {
+    if (Serial.available() >= receiveCapacity) {
+        overflowCount++;
+    }
+
+    // Serial.read() doesn't wait, and only what had arrived is read, so a
+    // chatty host can't keep us here.
+    for (int waiting = Serial.available(); waiting > 0; waiting--) {
+        const char c = Serial.read();
+        if (c != '\n') {
+            if (length < lineSize - 1) {
+                line[length++] = c;
+            } else {
+                dropping = true;
+            }
+            continue;
+        }
+
+        const bool wasDropping = dropping;
+        const size_t end = (length && line[length - 1] == '\r') ? length - 1 : length;
+        line[end] = '\0';
+        length = 0;
+        dropping = false;
+        if (wasDropping) {
+            droppedCount++;
+            continue;
+        }
+        return line;
+    }
+    return nullptr;
+}
+
+unsigned int droppedLines() {
+    return droppedCount;
+}
+
+unsigned int overflows() {
+    return overflowCount;
+}
+
+void printStatus() {
+    Serial.print("Lines dropped (too long): ");
+    Serial.println(droppedCount);
+    Serial.print("Receive buffer overflows: ");
+    Serial.println(overflowCount);
+}
+}
@@ -0,0 +1,39 @@
+#ifndef LineReader_h
+#define LineReader_h
+
+#include <Arduino.h>
+
+// Assembles command lines from Serial a few bytes at a time, so a slow or
+// half-sent line never holds up loop() the way readStringUntil() did.
+namespace LineReader {
+
+// Longest line kept, including the terminator
+constexpr size_t lineSize {64};
+
+/**
+ * @brief Take whatever bytes have already arrived, without waiting for more.
+ * 
+ * @return A finished line, null-terminated without the newline (or a
+ * trailing carriage return), or nullptr if none is finished yet. It stays
+ * valid until the next call, and parsing it in place is fine.
+ */
+char* poll();
+
+/**
+ * @brief Lines longer than lineSize - 1, which are dropped whole rather
+ * than run cut short.
+ * 
+ */
+unsigned int droppedLines();
+
+/**
+ * @brief How often the serial receive buffer was found full, meaning bytes
+ * may have been lost before they reached us.
+ * 
+ */
+unsigned int overflows();
+
+void printStatus();
+}
+
+#endif
@@ -1,69 +1,90 @@
 #include "MotorSystem.h"
 
-#include <AccelStepper.h>
 #include "Lengths.h"
+#include "Planner.h"
+#include "StepGenerator.h"
 
 namespace MotorSystem {
 using namespace Lengths;
 namespace {
-constexpr int stepXPin {2};
-constexpr int dirXPin {5};
-constexpr int stepYPin {3};
-constexpr int dirYPin {6};
-
-// Left and right
-AccelStepper steppers[2] {
-    {AccelStepper::DRIVER, stepYPin, dirYPin},
-    {AccelStepper::DRIVER, stepXPin, dirXPin}
-};
-
-constexpr int enableMotorPin {8};
-
-constexpr int stepsInMotor {200};
-constexpr int microsteps {8};
-constexpr double stepsPerRotation {stepsInMotor * microsteps};
-
-constexpr int secondsPerMinute {60};
-
-constexpr double maxRotationsPerMinute {500};
-constexpr double maxRotationsPerSecond {maxRotationsPerMinute / secondsPerMinute};
-constexpr double maxStepsPerSecond {maxRotationsPerSecond * stepsPerRotation};
+using Config = Rig::Active;
 
-constexpr double rotationsPerMinute {300};
-static_assert(rotationsPerMinute <= maxRotationsPerMinute);
-constexpr double rotationsPerSecond {rotationsPerMinute / secondsPerMinute};
+constexpr uint8_t enableMotorPin {Config::enablePin};  // Active low
 
+constexpr double maxStepsPerSecond {Config::maxStepsPerSecond};
+constexpr double secondsToFullSpeed {Config::secondsToFullSpeed};
+constexpr double stepsPerInch {Config::stepsPerInch};
+constexpr double safeSteps {Config::safeSteps};
+constexpr double gridLimit {Config::gridLimit};
 
-// Parameters of the stepper motors.
+TruePosition lastTruePosition {width / 2, width / 2};  // Seeds the next inverse
 
-constexpr double stepRadius = {stepsPerRotation / (2*PI)};
+// Drivers need a moment after power-up before they take steps reliably.
+constexpr unsigned long settleMillis {100};
+unsigned long idleMillis {2000};
 
-// // Parameters of the string set-up (including initial conditions)
-constexpr double stepsPerInch {stepsPerRotation / inchPerRotation};
+bool quiet {false};  // No warnings while the host expects only replies or frames
 
-constexpr double safetyFactor = 1.1;
-constexpr double safeSteps = stepsPerInch * width * safetyFactor;
-
-const double stepsPerSecond {rotationsPerSecond * stepsPerRotation};
-
-constexpr double slowFactor {0.9};
-static_assert(0 < slowFactor && slowFactor <= 1);
-const double gridLimit {slowFactor / sqrt(2) * stepsPerSecond};
+void warn(const char* message) {
+  if (!quiet) {
+    Serial.println(message);
+  }
+}
 
-const StringSpeed defaultStringSpeed {stepsPerSecond, stepsPerSecond};
-StringSpeed currentSpeed {defaultStringSpeed};
+enum class Driver {
+  Off,
+  Settling,  // Energized, but motion is held until settleMillis pass
+  On,
+};
 
-GridSpeed bearing {gridLimit, gridLimit};
+Driver driver {Driver::Off};
+unsigned long changedAt {0};  // When the drivers were energized, or last had work
 
+// Commands arriving while the drivers settle mustn't restart the wait.
 void enable() {
-  steppers[1].enableOutputs();
-  delay(100);  // Doesn't impact motor stuttering
+  switch (driver) {
+    case Driver::Off:
+    digitalWrite(enableMotorPin, LOW);
+    driver = Driver::Settling;
+    changedAt = millis();
+    break;
+
+    case Driver::On:
+    changedAt = millis();
+    break;
+
+    default:
+    break;
+  }
 }
 
 void disable() {
-  delay(50);
-  steppers[0].disableOutputs();
-  currentSpeed = defaultStringSpeed;
+  digitalWrite(enableMotorPin, HIGH);
+  driver = Driver::Off;
+}
+
+// Never blocks: settling and idling are both checked against millis().
+void updateDriver() {
+  const auto now = millis();
+  switch (driver) {
+    case Driver::Settling:
+    if (now - changedAt >= settleMillis) {
+      driver = Driver::On;
+      changedAt = now;
+    }
+    break;
+
+    case Driver::On:
+    if (stillMoving()) {
+      changedAt = now;
+    } else if (now - changedAt >= idleMillis) {
+      disable();
+    }
+    break;
+
+    default:
+    break;
+  }
 }
 
 Steps inchToSteps(TotalLengths lengths) {
@@ -73,65 +94,210 @@ Steps inchToSteps(TotalLengths lengths) {
   return outSteps;
 }
 
-GridSpeed normalizeSpeed(TruePosition delta) {
-  const auto greater = static_cast<double>(max(delta.x, delta.y));
-  const auto getComponent = [greater](double num) {
-    return (static_cast<double>(num) / greater) * gridLimit;
-  };
-  
-  const auto out = GridSpeed(getComponent(delta.x), getComponent(delta.y));
-  return out;
+TotalLengths stepsToInch(Steps steps) {
+  TotalLengths lengths;
+  lengths.left = static_cast<double>(steps.left) / stepsPerInch;
+  lengths.right = static_cast<double>(steps.right) / stepsPerInch;
+  return lengths;
+}
+
+// Velocity mode: a fixed-rate control loop streams short segments along
+// the commanded bearing instead of planning discrete moves.
+constexpr unsigned long tickMicros {5000};  // 200 Hz
+constexpr double tickSeconds {tickMicros / 1e6};
+constexpr int leadTicks {2};  // Queued ahead so a late loop() doesn't stall the motors
+
+// How far the strings may move (inches) before the full kinematics run again.
+constexpr double relinearizeInches {0.25};
+
+bool streaming {false};
+bool streamStarted {false};  // Queued moves have drained and the loop has taken over
+GridSpeed velocity {0, 0};  // Commanded, in inches per second
+StringSpeed stringSpeed {0, 0};  // Streamed, in steps per second; slews toward the command
+StringPair residual {0, 0};  // Fractions of a step carried to the next tick
+Steps streamed;  // Where the queued segments end
+Jacobian linearization {TruePosition(width / 2, width / 2)};
+unsigned long lastTick {0};
+
+// Reported by printStatus()
+unsigned long streamStartMicros {0};
+unsigned long tickCount {0};
+unsigned long lateTicks {0};
+unsigned long droppedTicks {0};  // Segment ring was full
+unsigned long computeMicrosTotal {0};
+unsigned long computeMicrosMax {0};
+unsigned long relinearizations {0};
+
+// Whether the blocker is at an edge of the workspace and heading further out.
+bool leaving(TruePosition truePosition, GridSpeed bearing) {
+  return (truePosition.x <= 0 && bearing.x < 0)
+      || (truePosition.x >= width && bearing.x > 0)
+      || (truePosition.y <= minHeight && bearing.y < 0);
 }
 
-StringSpeed normalizeSpeed(Steps steps) {
-  const auto greater = static_cast<long double>(max(steps.left, steps.right));
-  const auto getComponent = [greater](long num) {
-    return static_cast<double>((static_cast<long double>(num) / greater) * stepsPerSecond);
-  };
-  return StringSpeed(getComponent(steps.left), getComponent(steps.right));
+void endStream() {
+  streaming = false;
+  velocity = GridSpeed(0, 0);
+  stringSpeed = StringSpeed(0, 0);
+  if (streamStarted) {
+    // Until then the planner still holds its own moves, and knows where they end.
+    Planner::setSteps(streamed);
+  }
+  streamStarted = false;
 }
 
-StringSpeed speedFromBearing() {
-  const auto truePosition = getTruePosition();
-  const auto factor = truePosition.x * bearing.x + truePosition.y * bearing.y;
-  const auto tangential = getTangential();
-  const auto out = StringSpeed(factor/tangential.left, -(factor - width*bearing.x)/tangential.right);
-  Serial.print("Speed from bearing: ");
-  Serial.println(out);
-  return out;
+void slew(double& speed, double target, double maxChange) {
+  speed += constrain(target - speed, -maxChange, maxChange);
 }
 
+void relinearize(TotalLengths lengths) {
+  linearization = Jacobian(TruePosition(lengths, linearization.toTruePosition(lengths)));
+  relinearizations++;
+}
+
+// Between relinearizations both the pose and the string speeds come from
+// the Jacobian, which is a handful of multiplies.
+void tick() {
+  const auto began = micros();
+
+  const auto lengths = stepsToInch(streamed);
+  if (linearization.drift(lengths) > relinearizeInches) {
+    relinearize(lengths);
+  }
+  const auto truePosition = linearization.toTruePosition(lengths);
+  if (leaving(truePosition, velocity) || streamed.left + streamed.right < safeSteps) {
+    warn("Velocity stopped: edge of workspace");
+    endStream();
+    return;
+  }
+
+  const auto target = linearization.toStringSpeed(velocity);
+  const double maxChange = stepsPerSecond / secondsToFullSpeed * tickSeconds;
+  slew(stringSpeed.left, target.left * stepsPerInch, maxChange);
+  slew(stringSpeed.right, target.right * stepsPerInch, maxChange);
+
+  const double fastest = max(fabs(stringSpeed.left), fabs(stringSpeed.right));
+  if (fastest > maxStepsPerSecond) {
+    stringSpeed.left *= maxStepsPerSecond / fastest;
+    stringSpeed.right *= maxStepsPerSecond / fastest;
+  }
+
+  const StringPair due(residual.left + stringSpeed.left * tickSeconds,
+                       residual.right + stringSpeed.right * tickSeconds);
+  const Steps steps(lround(due.left), lround(due.right));
+
+  // The loop, not the queue, keeps the cadence here, so a gap between
+  // slow steps isn't an underrun. If the ring is full the tick's steps are
+  // dropped rather than carried, so the next one can't burst past top speed.
+  const long count = max(labs(steps.left), labs(steps.right));
+  const bool queued = count == 0
+      || StepGenerator::push(StepGenerator::Segment{steps, StepGenerator::intervalFor(count / tickSeconds), true});
+  if (queued) {
+    residual = StringPair(due.left - steps.left, due.right - steps.right);
+    streamed = streamed + steps;
+  } else {
+    droppedTicks++;
+  }
+
+  const bool commandedStop = velocity.x == 0 && velocity.y == 0;
+  if (commandedStop && stringSpeed.left == 0 && stringSpeed.right == 0) {
+    endStream();
+  }
+
+  const auto elapsed = micros() - began;
+  tickCount++;
+  computeMicrosTotal += elapsed;
+  computeMicrosMax = max(computeMicrosMax, elapsed);
+}
+
+void stream() {
+  if (!streamStarted) {
+    if (!Planner::empty()) {
+      Planner::run();
+      return;
+    }
+    streamStarted = true;
+    streamed = Planner::getPlannedSteps();
+    residual = StringPair(0, 0);
+    lastTick = micros();
+    streamStartMicros = lastTick;
+    tickCount = lateTicks = droppedTicks = computeMicrosTotal = computeMicrosMax = relinearizations = 0;
+    relinearize(stepsToInch(streamed));
+    for (int i = 0; i < leadTicks && streaming; i++) {
+      tick();
+    }
+    return;
+  }
+
+  const auto now = micros();
+  if (now - lastTick < tickMicros) {
+    return;
+  }
+  lastTick += tickMicros;
+  if (now - lastTick >= tickMicros) {
+    // Fell more than a tick behind; skip ahead rather than burst.
+    lateTicks++;
+    lastTick = now;
+  }
+  tick();
+}
+
+bool queue(Steps target) {
+  if (streaming) {
+    // A discrete move takes over from velocity mode where the stream ends.
+    endStream();
+  }
+  enable();
+  if (!Planner::push(target)) {
+    warn("Move dropped: queue full");
+    return false;
+  }
+  return true;
+}
 }
 
 bool stillMoving() {
-  bool active = steppers[0].distanceToGo() || steppers[1].distanceToGo();
-  return active;
+  return streaming || !Planner::empty() || !StepGenerator::idle();
 }
 
+bool canQueue() {
+  return !Planner::full();
+}
+
+// Pulses come from the timer interrupt; this keeps it fed once the drivers
+// are ready and turns them off after they've sat idle for a while.
 void run() {
-  steppers[0].setSpeed(currentSpeed.left);
-  steppers[1].setSpeed(currentSpeed.right);
+  updateDriver();
+  if (driver != Driver::On) {
+    return;
+  }
 
-  steppers[0].runSpeedToPosition();
-  steppers[1].runSpeedToPosition();
-  if (!stillMoving()) {
-    disable();
+  if (streaming) {
+    stream();
+  } else {
+    Planner::run();
   }
 }
 
+void setIdleTimeout(unsigned long milliseconds) {
+  idleMillis = milliseconds;
+}
+
+void setQuiet(bool _quiet) {
+  quiet = _quiet;
+}
+
 void init(Tangential tangential) {
-  for (auto& stepper : steppers) {
-    stepper.setPinsInverted(false, false, true);
-    stepper.setEnablePin(enableMotorPin);
-    stepper.setMaxSpeed(maxStepsPerSecond);
-    stepper.setSpeed(0);
-  }
+  pinMode(enableMotorPin, OUTPUT);
+  StepGenerator::init();
+  Planner::init(stepsPerSecond, stepsPerSecond / secondsToFullSpeed);
 
   const auto radial = Radial(tangential);
   originOffset = radial.findOffset();
   const auto truePosition = TruePosition(radial);
   const TotalLengths lengths = TotalLengths(truePosition, radial, tangential);
   zero(lengths);
+  lastTruePosition = truePosition;
   disable();
 }
 
@@ -140,54 +306,107 @@ void step(TotalLengths lengths) {
   step(steps);
 }
 
+// Moves queue behind each other and blend through the corners; the longer
+// string cruises at stepsPerSecond and the shorter one is interleaved with it.
 void step(Steps steps) {
-  enable();
-  steppers[0].move(steps.left);
-  steppers[1].move(-steps.right);
-  currentSpeed = normalizeSpeed(steps);
+  if (streaming) {
+    // The planner only learns where the stream ends once it does.
+    endStream();
+  }
+  queue(Planner::getPlannedSteps() + steps);
 }
 
-void go(TotalLengths lengths) {
+bool go(TotalLengths lengths) {
   auto steps = inchToSteps(lengths);
   if (steps.left + steps.right < safeSteps) {
-    Serial.println("Step failed: too close to danger length");
-  } else {
-    go(steps);
+    warn("Step failed: too close to danger length");
+    return false;
   }
+  return go(steps);
 }
 
-void go(Steps steps) {
-  enable();
-  const auto current = getSteps();
-  const auto newSteps = steps - current;
-  step(newSteps);
+bool go(Steps steps) {
+  return queue(steps);
+}
+
+void stop() {
+  if (streaming) {
+    // Slew down to rest; the stream ends itself once the strings stop.
+    velocity = GridSpeed(0, 0);
+  }
+  Planner::stop();
 }
 
 void zero(TotalLengths lengths) {
-  auto steps = inchToSteps(lengths);
-  steppers[0].setCurrentPosition(steps.left);
-  steppers[1].setCurrentPosition(-steps.right);
+  const auto steps = inchToSteps(lengths);
+  StepGenerator::setSteps(steps);
+  Planner::setSteps(steps);
 }
 
-void setBearing(TruePosition end) {
-  const auto start = getTruePosition();
-  const auto delta = end - start;
-  bearing = normalizeSpeed(delta);
+void setVelocity(GridSpeed inchesPerSecond) {
+  // Keep the faster string within reach however the bearing is turned.
+  const double limit = gridLimit / stepsPerInch;
+  const double speed = sqrt(sq(inchesPerSecond.x) + sq(inchesPerSecond.y));
+  const double scale = speed > limit ? limit / speed : 1;
+  velocity = GridSpeed(inchesPerSecond.x * scale, inchesPerSecond.y * scale);
+
+  if (!streaming) {
+    if (speed == 0) {
+      return;
+    }
+    // Let the queued moves finish first.
+    streaming = true;
+    streamStarted = false;
+  }
+  enable();
+}
+
+void printStatus() {
+  Serial.print("Moves queued: ");
+  Serial.println(Planner::queued());
+  Serial.print("Segments queued: ");
+  Serial.println(StepGenerator::queued());
+  Serial.print("Underruns: ");
+  Serial.println(StepGenerator::underruns());
+
+  if (tickCount) {
+    const double seconds = (micros() - streamStartMicros) / 1e6;
+    Serial.print("Control ticks per second: ");
+    Serial.println(tickCount / seconds);
+    Serial.print("Late ticks: ");
+    Serial.println(lateTicks);
+    Serial.print("Dropped ticks: ");
+    Serial.println(droppedTicks);
+    Serial.print("Tick compute (us, mean/max): ");
+    Serial.print(computeMicrosTotal / tickCount);
+    Serial.print(" / ");
+    Serial.println(computeMicrosMax);
+    Serial.print("Relinearizations: ");
+    Serial.println(relinearizations);
+  }
 }
 
 TotalLengths getLengths() {
-  TotalLengths lengths;
-  auto steps = getSteps();
-  lengths.left = static_cast<double>(steps.left) / stepsPerInch;
-  lengths.right = static_cast<double>(steps.right) / stepsPerInch;  // Note negative
-  return lengths;
+  return stepsToInch(getSteps());
+}
+
+TotalLengths getPlannedLengths() {
+  // A running stream is ahead of the planner.
+  return stepsToInch(streamStarted ? streamed : Planner::getPlannedSteps());
 }
 
 Steps getSteps() {
-  Steps steps;
-  steps.left = steppers[0].currentPosition();
-  steps.right = -steppers[1].currentPosition();
-  return steps;
+  return StepGenerator::getSteps();
+}
+
+TruePosition getTruePosition() {
+  lastTruePosition = TruePosition(getLengths(), lastTruePosition);
+  return lastTruePosition;
+}
+
+TruePosition getPlannedTruePosition() {
+  lastTruePosition = TruePosition(getPlannedLengths(), lastTruePosition);
+  return lastTruePosition;
 }
 
 
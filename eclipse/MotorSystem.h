@@ -1,16 +1,29 @@
 #ifndef MotorSystem_h
 #define MotorSystem_h
 
-#include <AccelStepper.h>
 #include "Lengths.h"
 
-// Used as a wrapper for the Stepper, but with some added
-// features.
+// Turns string lengths into queued moves for the StepGenerator, but with
+// some added features.
 namespace MotorSystem {
 using namespace Lengths;
 
 void run();
 
+/**
+ * @brief How long the drivers stay energized (holding position) after
+ * motion ends before they're turned off.
+ * 
+ */
+void setIdleTimeout(unsigned long milliseconds);
+
+/**
+ * @brief Hold back the warnings about refused and stopped moves, for when
+ * the host reads nothing but replies or frames.
+ * 
+ */
+void setQuiet(bool quiet);
+
 void init(Tangential tangential);
 
 /**
@@ -29,10 +42,18 @@ void step(Steps steps);
  * @brief Command the motors to step to a certain position from
  * the zero position.
  * 
+ * @return false if the move was refused, too close to the danger length
+ * or with the queue full
  */
-void go(TotalLengths lengths);
+bool go(TotalLengths lengths);
 
-void go(Steps steps);
+bool go(Steps steps);
+
+/**
+ * @brief Drop queued moves and slow to a stop along the current one.
+ * 
+ */
+void stop();
 
 // void setOffset(double offset);
 
@@ -42,27 +63,59 @@ void go(Steps steps);
  */
 void zero(TotalLengths lengths);
 
-void setBearing(TruePosition end);
+/**
+ * @brief Glide continuously along a bearing (inches per second in the grid)
+ * until stopped, a new move arrives, or the edge of the workspace. A fixed
+ * 200 Hz control loop recomputes the string speeds from the current position
+ * through the Jacobian, relinearizing every quarter inch or so.
+ * Zero slows to a stop.
+ * 
+ */
+void setVelocity(GridSpeed inchesPerSecond);
 
 bool stillMoving();
 
+/**
+ * @brief Whether another step() or go() will fit in the motion queue.
+ * 
+ */
+bool canQueue();
+
+/**
+ * @brief Print how full the motion queues are, how often the step
+ * generator has run dry mid-move, and how the velocity loop is keeping up.
+ * 
+ */
+void printStatus();
+
 TotalLengths getLengths();
 
 Steps getSteps();
 
-extern const double stepsPerSecond;
+/**
+ * @brief Where the strings will be once every queued move is done.
+ * 
+ */
+TotalLengths getPlannedLengths();
+
+constexpr double stepsPerSecond {Rig::Active::stepsPerSecond};
 extern double originOffset;
 
-inline Tangential getTangential() {
-  return Tangential(getLengths());
-}
+/**
+ * @brief Solve for the pose from the step counts, seeded from the last
+ * solution so it usually takes one or two Newton iterations.
+ * 
+ */
+TruePosition getTruePosition();
+
+TruePosition getPlannedTruePosition();
 
 inline Radial getRadial() {
-  return Radial(getTangential());
+  return Radial(getTruePosition());
 }
 
-inline TruePosition getTruePosition() {
-  return TruePosition(getRadial());
+inline Tangential getTangential() {
+  return Tangential(getRadial());
 }
 
 inline Position getPosition() {
@@ -3,43 +3,156 @@
 namespace Parser {
 
 namespace {
-    CommandType processType(String commandString) {
+// Longest keyword, plus its terminator
+constexpr size_t nameSize {8};
 
-        #define parseCase(str, ct) if (commandString.equals(str)) \
-            {return CommandType::ct;}
+struct Keyword {
+    char name[nameSize];
+    uint8_t type;  // CommandType
+};
 
-        parseCase("getstep", GetStep);
-        parseCase("gostep", GoStep);
-        parseCase("step", ShiftStep);
+#define parseCase(str, ct) {str, static_cast<uint8_t>(CommandType::ct)}
 
-        parseCase("getinch", GetInch);
-        parseCase("goinch", GoInch);
-        parseCase("inch", ShiftInch);
+// Kept in flash; constexpr too so the hash table below is built from it
+// at compile time.
+constexpr Keyword keywords[] PROGMEM {
+    parseCase("getstep", GetStep),
+    parseCase("gostep", GoStep),
+    parseCase("step", ShiftStep),
 
-        parseCase("getpos", GetPosition);
-        parseCase("go", Go);
+    parseCase("getinch", GetInch),
+    parseCase("goinch", GoInch),
+    parseCase("inch", ShiftInch),
 
-        parseCase("origin", HardZero);
-        parseCase("fix", SoftZero);
+    parseCase("getpos", GetPosition),
+    parseCase("go", Go),
+    parseCase("vel", Velocity),
 
-        parseCase("settime", SetTime);
+    parseCase("origin", HardZero),
+    parseCase("fix", SoftZero),
 
-        parseCase("stop", Stop);
-        parseCase("start", Start);
-        parseCase("pause", Pause);
+    parseCase("settime", SetTime),
 
-        #undef parseCase
+    parseCase("stop", Stop),
+    parseCase("start", Start),
+    parseCase("pause", Pause),
 
+    parseCase("status", Status),
+    parseCase("test", Test),
+    parseCase("binary", Binary),
+    parseCase("stream", Stream),
+
+    parseCase("record", Record),
+    parseCase("end", EndRecord),
+    parseCase("play", Play),
+
+    parseCase("viewer", Viewer),
+    parseCase("drift", Drift),
+};
+
+#undef parseCase
+
+constexpr uint8_t keywordCount {sizeof(keywords) / sizeof(keywords[0])};
+
+// Everything below is worked out at compile time, so each constexpr
+// function is a single return, recursing where it would loop: the core
+// builds with gnu++11.
+constexpr size_t nameLength(const char* name) {
+    return *name ? 1 + nameLength(name + 1) : 0;
+}
+
+// First, third and last letters plus the length tell every keyword apart;
+// the weights were picked by search, and the static_assert below checks them.
+// No weights fit every keyword into 32 slots once there were 24 of them.
+constexpr uint8_t slots {64};
+
+constexpr uint8_t hash(const char* word, size_t length) {
+    return (static_cast<uint8_t>(word[0])
+            + 8 * static_cast<uint8_t>(word[length > 2 ? 2 : length - 1])
+            + 3 * static_cast<uint8_t>(word[length - 1])
+            + length) % slots;
+}
+
+constexpr uint8_t slotOf(uint8_t k) {
+    return hash(keywords[k].name, nameLength(keywords[k].name));
+}
+
+// The first keyword from k on that hashes to the slot, or -1
+constexpr int8_t indexFor(uint8_t slot, uint8_t k = 0) {
+    return k >= keywordCount ? -1
+           : slotOf(k) == slot ? static_cast<int8_t>(k)
+           : indexFor(slot, k + 1);
+}
+
+// Whether a later keyword lands in the same slot as any from k on
+constexpr bool collides(uint8_t k = 0) {
+    return k < keywordCount && (indexFor(slotOf(k), k + 1) >= 0 || collides(k + 1));
+}
+
+static_assert(!collides(), "Two keywords hash alike; pick new weights in hash()");
+
+struct Table {
+    int8_t index[slots];  // Into keywords, or -1
+};
+
+// 0, 1, ..., slots - 1 as a parameter pack, to fill the table in one go
+template<uint8_t... Slots>
+struct SlotList {};
+
+template<uint8_t N, uint8_t... Slots>
+struct MakeSlots : MakeSlots<N - 1, N - 1, Slots...> {};
+
+template<uint8_t... Slots>
+struct MakeSlots<0, Slots...> {
+    using type = SlotList<Slots...>;
+};
+
+template<uint8_t... Slots>
+constexpr Table makeTable(SlotList<Slots...>) {
+    return Table{{indexFor(Slots)...}};
+}
+
+constexpr Table table PROGMEM {makeTable(MakeSlots<slots>::type{})};
+
+CommandType typeAt(uint8_t k) {
+    return static_cast<CommandType>(pgm_read_byte(&keywords[k].type));
+}
+
+// These keep the rest of the line as text, for their own module to read.
+bool takesText(CommandType type) {
+    return type == CommandType::SetTime || type == CommandType::Viewer;
+}
+}
+
+CommandType lookup(const char* keyword) {
+    const size_t length = strlen(keyword);
+    if (length == 0 || length >= nameSize) {
+        return CommandType::Invalid;
+    }
+    const int8_t k = pgm_read_byte(&table.index[hash(keyword, length)]);
+    if (k < 0 || strcmp_P(keyword, keywords[k].name) != 0) {
         return CommandType::Invalid;
     }
+    return typeAt(k);
+}
+
+CommandType lookupLinear(const char* keyword) {
+    for (uint8_t k = 0; k < keywordCount; k++) {
+        if (strcmp_P(keyword, keywords[k].name) == 0) {
+            return typeAt(k);
+        }
+    }
+    return CommandType::Invalid;
 }
 
-Command::Command(CommandType t, String _data, double n1, double n2)
+Command::Command(CommandType t, const char* _data, double n1, double n2)
     :   type{t},
-        data{_data},
         num1{n1},
         num2{n2}
-    {}
+    {
+        strncpy(data, _data, dataSize - 1);
+        data[dataSize - 1] = '\0';
+    }
 
 
 size_t Command::printTo(Print& p) const {
@@ -60,9 +173,6 @@ Command parse(String string) {
     String intString1 = "";
     String intString2 = "";
 
-    Serial.println("> " + string);
-    Serial.print("Entered: ");
-
     int split1 = string.indexOf(" ");
     int split2 = string.indexOf(" ", split1 + 1);
 
@@ -77,13 +187,33 @@ Command parse(String string) {
         }
     }
 
-    CommandType type = processType(commandString);
+    CommandType type = lookup(commandString.c_str());
 
     // +2 from the substring index because we want after the space.
-    String data = (type == CommandType::SetTime) ? string.substring(sizeof(commandString) + 2) : "";
+    String data = takesText(type) ? string.substring(sizeof(commandString) + 2) : "";
     double number1 = intString1.toDouble();
     double number2 = intString2.toDouble();
 
-    return Command(type, data, number1, number2);
+    return Command(type, data.c_str(), number1, number2);
+}
+
+Command parse(char* line) {
+    char* rest = strchr(line, ' ');
+    if (rest) {
+        *rest++ = '\0';
+    }
+
+    const CommandType type = lookup(line);
+    if (takesText(type)) {
+        return Command(type, rest ? rest : "", 0, 0);
+    }
+
+    // strtod() skips the spaces between numbers and gives 0 when there are none.
+    double numbers[2] {0, 0};
+    if (rest) {
+        numbers[0] = strtod(rest, &rest);
+        numbers[1] = strtod(rest, &rest);
+    }
+    return Command(type, "", numbers[0], numbers[1]);
 }
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Parser {
 
 enum class CommandType {
         Invalid,
-        Test,  // test [testNumber] (executes a test in Test) [UNUSED]
+        Test,  // test [testNumber] (executes a test in Test)
         
         Stop, // stop whatever motion
         Start,  // begin checking scheduled tasks
@@ -25,23 +25,61 @@ enum class CommandType {
 
         GetPosition,  // getpos (get x, y coordinates)
         Go, // go [x] [y]
+        Velocity,  // vel [x] [y] (glide in inches per second until stopped)
         
         HardZero, // origin [str1] [str2] (make this new origin) Warning: not robust
         SoftZero, // fix [str1] [str2] (adjust str lengths and position to match; keeps old origin)
+
+        Status,  // status (queue depths, underruns and control loop timing)
+
+        // The values above are also the binary frame types (see Binary.h) and
+        // are saved in programs (see Program.h), so add new ones at the end.
+        Binary,  // binary [on] (1 switches to framed binary commands, 0 back to text)
+        Stream,  // stream [on] (1 answers every command with the move queue's credit)
+
+        // Replies while streaming, sent but never parsed. Each carries the
+        // free slots in the move queue.
+        Ack,  // ok [credit] (carried out or queued)
+        Nack,  // no [credit] (not carried out: bad, or the queue was full)
+        Credit,  // credit [credit] (a queued move has started, freeing a slot)
+
+        Record,  // record (store the commands that follow as the program, instead of running them)
+        EndRecord,  // end (save the program)
+        Play,  // play [times] (replay the program; 0 loops until stopped)
+
+        Viewer,  // viewer [x] [y] [z] (whose eyes the sun tracking shades; read from the string data)
+        Drift,  // drift [inches] (track the sun only when the shadow drifts this far; 0 for a steady pace)
 };
 
+// One past the last CommandType, for checking values read back in; move it
+// along with the end of the list.
+constexpr uint8_t typeCount {static_cast<uint8_t>(CommandType::Drift) + 1};
+
+// Longest text a command carries, e.g. "2023.02.06 19:52 -5" for settime
+constexpr size_t dataSize {24};
+
 class Command : public Printable {
 public:
-    Command(CommandType t, String data, double n1, double n2);
+    Command(CommandType t, const char* data, double n1, double n2);
 
     size_t printTo(Print& p) const;
 
     CommandType type;
     double num1;
     double num2;
-    String data;
+    char data[dataSize];  // Cut short if longer
 };
 
+/**
+ * @brief The CommandType for a keyword, or Invalid. The keyword hashes
+ * straight to the only one it could be, so it costs one string compare.
+ * 
+ */
+CommandType lookup(const char* keyword);
+
+// Tries every keyword in turn, as parsing used to; kept to benchmark against
+CommandType lookupLinear(const char* keyword);
+
 /**
  * @brief 
  * 
@@ -52,6 +90,14 @@ public:
  */
 Command parse(String string);
 
+/**
+ * @brief Same as parse(String), but splits the line in place (overwriting
+ * the first space) and never touches the heap.
+ * 
+ * @param line null-terminated, without the newline
+ */
+Command parse(char* line);
+
 const Command empty {CommandType::Invalid, "", 0, 0};
 }
 
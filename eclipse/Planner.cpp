@@ -0,0 +1,256 @@
+#include "Planner.h"
+
+#include <Arduino.h>
+#include "StepGenerator.h"
+
+namespace Planner {
+namespace {
+// How far the path may cut inside a corner, in steps. Bigger means
+// faster corners.
+constexpr double junctionDeviation {20};
+
+// Length in time of each segment handed to the StepGenerator.
+constexpr double sliceTime {0.02};
+
+// Keeps a block that starts from rest from never leaving.
+constexpr double minRate {1};
+
+struct Block {
+    Steps delta;
+    double length;  // Euclidean, in steps
+    double nominalRate;  // Cruise speed along the path (steps per second)
+    double acceleration;  // Along the path (steps per second squared)
+    double maxEntryRate;  // Set by the corner with the previous block
+    double entryRate;
+};
+
+constexpr uint8_t queueSize {8};
+Block blocks[queueSize];
+uint8_t head {0};  // Being sliced
+uint8_t tail {0};  // Next to fill
+
+double maxRate {0};
+double maxAcceleration {0};
+
+Steps planned;  // End of the last queued block
+
+// Progress through the block at the head, up to the last slice handed over.
+Steps start;
+Steps emitted;
+double travelled {0};
+double headRate {0};
+
+uint8_t next(uint8_t i) {
+    return (i + 1) % queueSize;
+}
+
+uint8_t previous(uint8_t i) {
+    return (i + queueSize - 1) % queueSize;
+}
+
+// Fastest rate reachable from `from` over `distance` at the block's acceleration.
+double reachable(const Block& block, double from, double distance) {
+    return sqrt(sq(from) + 2 * block.acceleration * distance);
+}
+
+double exitRate() {
+    const auto following = next(head);
+    return following == tail ? 0 : blocks[following].entryRate;
+}
+
+// The trapezoid (or triangle) for the head block, as speed against distance.
+double rateAt(double s) {
+    const Block& block = blocks[head];
+    const double accelerating = reachable(block, headRate, s - travelled);
+    const double decelerating = reachable(block, exitRate(), block.length - s);
+    return min(min(accelerating, decelerating), block.nominalRate);
+}
+
+/**
+ * @brief Junction deviation: the fastest speed at which a circle through the
+ * corner, no further than junctionDeviation from it, keeps within the
+ * acceleration limit.
+ *
+ */
+double junctionRate(const Block& before, const Block& after) {
+    const double cruise = min(before.nominalRate, after.nominalRate);
+    const double dot = static_cast<double>(before.delta.left) * after.delta.left
+                     + static_cast<double>(before.delta.right) * after.delta.right;
+    const double cosTurn = dot / (before.length * after.length);
+
+    // Half the angle between the incoming and outgoing paths
+    const double sinHalf = sqrt(0.5 * (1 + cosTurn));
+    if (sinHalf > 0.999) {
+        return cruise;
+    }
+    const double acceleration = min(before.acceleration, after.acceleration);
+    return min(sqrt(acceleration * junctionDeviation * sinHalf / (1 - sinHalf)), cruise);
+}
+
+void recalculate() {
+    // Backward: every block must be able to slow to the next one's entry,
+    // and the last must be able to stop. The head is already moving.
+    double exit = 0;
+    for (uint8_t i = previous(tail); i != head; i = previous(i)) {
+        Block& block = blocks[i];
+        block.entryRate = min(block.maxEntryRate, reachable(block, exit, block.length));
+        exit = block.entryRate;
+    }
+
+    // Forward: no block can enter faster than the one before can accelerate to.
+    const Block& current = blocks[head];
+    double entry = reachable(current, headRate, current.length - travelled);
+    for (uint8_t i = next(head); i != tail; i = next(i)) {
+        Block& block = blocks[i];
+        block.entryRate = min(block.entryRate, entry);
+        entry = reachable(block, block.entryRate, block.length);
+    }
+}
+
+void beginHead() {
+    travelled = 0;
+    emitted = Steps();
+    headRate = head == tail ? 0 : blocks[head].entryRate;
+}
+
+// Hand the next constant-rate piece of the head block to the StepGenerator.
+void slice() {
+    const Block& block = blocks[head];
+    const double master = max(labs(block.delta.left), labs(block.delta.right));
+    const double stepLength = block.length / master;
+    const double remaining = block.length - travelled;
+
+    double distance = headRate * sliceTime + 0.5 * block.acceleration * sq(sliceTime);
+    distance = max(distance, stepLength);
+    if (remaining - distance < stepLength) {
+        distance = remaining;
+    }
+    const double end = travelled + distance;
+    const bool last = distance == remaining;
+
+    const double endRate = rateAt(end);
+    // The trapezoid rule is exact while the acceleration is constant, but
+    // the middle does better for a short block that starts and ends at rest.
+    const double meanRate = max(max(0.5 * (headRate + endRate), rateAt(travelled + distance / 2)), minRate);
+    const double time = distance / meanRate;
+
+    const double fraction = end / block.length;
+    const Steps target = last ? block.delta
+                              : Steps(lround(block.delta.left * fraction), lround(block.delta.right * fraction));
+    const Steps steps = target - emitted;
+    const long count = max(labs(steps.left), labs(steps.right));
+    if (count) {
+        const bool stopping = last && next(head) == tail;
+        StepGenerator::push(StepGenerator::Segment{steps, StepGenerator::intervalFor(count / time), stopping});
+    }
+
+    emitted = target;
+    travelled = end;
+    headRate = endRate;
+
+    if (last) {
+        start = start + block.delta;
+        head = next(head);
+        beginHead();
+    }
+}
+}
+
+void init(double _maxRate, double acceleration) {
+    maxRate = _maxRate;
+    maxAcceleration = acceleration;
+}
+
+bool push(Steps target) {
+    if (full()) {
+        return false;
+    }
+
+    const Steps delta = target - planned;
+    if (!delta.left && !delta.right) {
+        return true;
+    }
+
+    Block& block = blocks[tail];
+    const double left = delta.left;
+    const double right = delta.right;
+    const double master = max(fabs(left), fabs(right));
+
+    // Limits are for the faster axis, so scale them onto the diagonal.
+    block.delta = delta;
+    block.length = sqrt(sq(left) + sq(right));
+    block.nominalRate = maxRate * block.length / master;
+    block.acceleration = maxAcceleration * block.length / master;
+    block.entryRate = 0;
+
+    const bool wasEmpty = empty();
+    block.maxEntryRate = wasEmpty ? 0 : junctionRate(blocks[previous(tail)], block);
+
+    tail = next(tail);
+    planned = target;
+    if (wasEmpty) {
+        start = target - delta;
+        beginHead();
+    }
+
+    recalculate();
+    return true;
+}
+
+bool full() {
+    return next(tail) == head;
+}
+
+bool empty() {
+    return head == tail;
+}
+
+uint8_t queued() {
+    return (tail + queueSize - head) % queueSize;
+}
+
+void run() {
+    while (!empty() && !StepGenerator::full()) {
+        slice();
+    }
+}
+
+// Segments already in the StepGenerator still play out before the slowdown.
+void stop() {
+    if (empty()) {
+        return;
+    }
+
+    tail = next(head);
+    Block& block = blocks[head];
+    const double stopping = sq(headRate) / (2 * block.acceleration);
+    const double end = travelled + stopping;
+
+    if (end < block.length) {
+        const double master = max(labs(block.delta.left), labs(block.delta.right));
+        if (stopping * master < block.length) {
+            // Less than a step to go, so stop where the last slice ends.
+            start = start + emitted;
+            tail = head;
+            beginHead();
+        } else {
+            // Shrink the block along the same line so the slices so far still fit.
+            const double fraction = end / block.length;
+            block.delta = Steps(lround(block.delta.left * fraction), lround(block.delta.right * fraction));
+            block.length = end;
+        }
+    }
+    planned = empty() ? start : start + block.delta;
+}
+
+Steps getPlannedSteps() {
+    return planned;
+}
+
+void setSteps(Steps steps) {
+    head = tail;
+    planned = steps;
+    start = steps;
+    beginHead();
+}
+}
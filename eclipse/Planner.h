@@ -0,0 +1,65 @@
+#ifndef Planner_h
+#define Planner_h
+
+#include <Arduino.h>
+#include "Lengths.h"
+
+// Queues moves (in steps) and plans an acceleration profile across them so
+// that consecutive moves blend at speed instead of each coming to a stop.
+//
+// Each block's speed along its path is the smallest of three curves:
+// accelerating from its entry speed, its cruise speed, and decelerating to
+// the entry speed of the next block. Look-ahead raises or lowers the entry
+// speeds as blocks are added, and run() slices the current block into short
+// constant-rate segments for the StepGenerator.
+namespace Planner {
+using Lengths::Steps;
+
+/**
+ * @brief Limits for the faster of the two axes.
+ *
+ * @param maxRate in steps per second
+ * @param acceleration in steps per second squared
+ */
+void init(double maxRate, double acceleration);
+
+/**
+ * @brief Queue a move to an absolute position behind the planned ones.
+ *
+ * @return false if the queue is full.
+ */
+bool push(Steps target);
+
+bool full();
+
+uint8_t queued();
+
+/**
+ * @brief Whether every block has been handed to the StepGenerator; the
+ * last segments may still be running.
+ *
+ */
+bool empty();
+
+/**
+ * @brief Top up the StepGenerator with the next slices of the current block.
+ *
+ */
+void run();
+
+/**
+ * @brief Drop the queued moves and decelerate to a stop along the current one.
+ *
+ */
+void stop();
+
+/**
+ * @brief Where the motors will be once every queued move is done.
+ *
+ */
+Steps getPlannedSteps();
+
+void setSteps(Steps steps);
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include "Program.h"
+
+#include <EEPROM.h>
+
+namespace Program {
+namespace {
+using Parser::CommandType;
+
+// Marks the EEPROM as holding a program rather than factory 0xFF
+constexpr uint8_t magic {0xEC};
+
+// Steps hold CommandType values, so bump this whenever they or Step change
+// and older programs read as empty rather than as other commands.
+constexpr uint8_t version {1};
+
+struct Header {
+    uint8_t magic;
+    uint8_t version;
+    uint8_t count;
+};
+
+// Only the numbers are kept, as float, which is all a double is on AVR.
+struct Step {
+    uint8_t type;
+    float first;
+    float second;
+};
+
+constexpr int headerAddress {0};
+constexpr int stepsAddress {sizeof(Header)};
+static_assert(stepsAddress + capacity * sizeof(Step) <= 1024, "Program must fit in the Uno's EEPROM");
+
+uint8_t recorded {0};
+
+int stepAddress(uint8_t index) {
+    return stepsAddress + index * sizeof(Step);
+}
+
+void writeHeader(uint8_t count) {
+    EEPROM.put(headerAddress, Header{magic, version, count});
+}
+
+bool storable(CommandType type) {
+    switch (type) {
+        case CommandType::Invalid:
+        case CommandType::SetTime:
+        case CommandType::Viewer:
+        case CommandType::Ack:
+        case CommandType::Nack:
+        case CommandType::Credit:
+        case CommandType::Record:
+        case CommandType::EndRecord:
+        case CommandType::Play:
+        return false;
+
+        default:
+        return static_cast<uint8_t>(type) < Parser::typeCount;
+    }
+}
+}
+
+void begin() {
+    recorded = 0;
+    writeHeader(0);
+}
+
+bool append(const Parser::Command& command) {
+    if (!storable(command.type) || recorded >= capacity) {
+        return false;
+    }
+
+    const Step step {static_cast<uint8_t>(command.type),
+                     static_cast<float>(command.num1), static_cast<float>(command.num2)};
+    EEPROM.put(stepAddress(recorded), step);
+    recorded++;
+    return true;
+}
+
+void finish() {
+    writeHeader(recorded);
+}
+
+uint8_t size() {
+    Header header;
+    EEPROM.get(headerAddress, header);
+    return header.magic == magic && header.version == version ? min(header.count, capacity) : 0;
+}
+
+Parser::Command read(uint8_t index) {
+    Step step;
+    EEPROM.get(stepAddress(index), step);
+    const auto type = static_cast<CommandType>(step.type);
+    if (!storable(type)) {
+        return Parser::empty;
+    }
+    return Parser::Command(type, "", step.first, step.second);
+}
+}
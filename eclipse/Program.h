@@ -0,0 +1,46 @@
+#ifndef Program_h
+#define Program_h
+
+#include <Arduino.h>
+#include "Parser.h"
+
+// A recorded list of already parsed commands kept in EEPROM, so a routine
+// can be replayed, or looped, without the host or any parsing.
+// Record with `record`, then the commands, then `end`; replay with `play`.
+namespace Program {
+
+constexpr uint8_t capacity {64};
+
+/**
+ * @brief Start a new, empty program, forgetting the saved one.
+ *
+ */
+void begin();
+
+/**
+ * @brief Add a command to the program being recorded.
+ *
+ * @return false if the program is full, or the command can't be stored
+ * (settime and viewer, which carry text, and the program commands
+ * themselves).
+ */
+bool append(const Parser::Command& command);
+
+/**
+ * @brief Save the recorded program so it survives a reset.
+ *
+ */
+void finish();
+
+// Commands in the saved program
+uint8_t size();
+
+/**
+ * @brief A step of the saved program, or Parser::empty if what's stored
+ * there couldn't have been recorded.
+ *
+ */
+Parser::Command read(uint8_t index);
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef Rig_h
+#define Rig_h
+
+#include <Arduino.h>
+
+// Everything that changes from one window to the next, in one place. Each
+// rig is a type of constants; Derived works out the rest from it at compile
+// time, so a build carries only the numbers for its own rig.
+//
+// Pick the rig with a build flag, e.g. with arduino-cli:
+//     --build-property "build.extra_flags=-DRIG=MiniEclipse"
+// and rerun py/workspace_table.py with the same name.
+namespace Rig {
+
+// The January 2023 mini-eclipse
+struct MiniEclipse {
+    // All measurements in inches from the contact point of the string on the spool.
+    static constexpr double width {41.232};  // Distance at motor level
+    static constexpr double minHeight {6};  // Limits max torque on spool; minimum permissible vertical displacement
+    static constexpr double height {55};  // Biggest permissible vertical displacement (less than longest string permitted)
+    static constexpr double inchPerRotation {2.37578};
+
+    static constexpr int stepsInMotor {200};
+    static constexpr int microsteps {8};
+    static constexpr double maxRotationsPerMinute {500};
+    static constexpr double rotationsPerMinute {300};
+    static constexpr double secondsToFullSpeed {0.5};
+
+    // CNC shield pins, left then right
+    static constexpr uint8_t enablePin {8};  // Active low
+    static constexpr uint8_t stepPins[2] {3, 2};
+    static constexpr uint8_t dirPins[2] {6, 5};
+
+    // The right motor is mounted mirrored, so paying out string turns it backwards.
+    static constexpr bool invertDirection[2] {false, true};
+
+    // Where the window is: degrees north and east, and the compass azimuth
+    // and tilt its outward normal adds to the sun's (see SunModel).
+    static constexpr double latitude {42.360015};
+    static constexpr double longitude {-71.087902};
+    static constexpr double windowAzimuth {155.75};
+    static constexpr double windowAltitude {0};
+
+    // Default eyes to shade: x, y as for the strings, then inches into the room
+    static constexpr double viewer[3] {15, 46, 35};
+};
+
+/**
+ * @brief The quantities that follow from a rig's constants.
+ *
+ */
+template<class Config>
+struct Derived : public Config {
+    static constexpr double radius {Config::inchPerRotation / (2*PI)};
+
+    static constexpr double stepsPerRotation {Config::stepsInMotor * Config::microsteps};
+    static constexpr double stepsPerInch {stepsPerRotation / Config::inchPerRotation};
+
+    static constexpr double maxStepsPerSecond {Config::maxRotationsPerMinute / 60 * stepsPerRotation};
+    static constexpr double stepsPerSecond {Config::rotationsPerMinute / 60 * stepsPerRotation};
+    static_assert(Config::rotationsPerMinute <= Config::maxRotationsPerMinute, "Running speed is over the motors' limit");
+
+    // Both strings together are never shorter than this, in steps.
+    static constexpr double safetyFactor {1.1};
+    static constexpr double safeSteps {stepsPerInch * Config::width * safetyFactor};
+
+    // Fastest grid speed in steps per second: either string can go that
+    // fast even moving diagonally.
+    static constexpr double slowFactor {0.9};
+    static_assert(0 < slowFactor && slowFactor <= 1, "slowFactor must be in (0, 1]");
+    static constexpr double gridLimit {slowFactor * M_SQRT1_2 * stepsPerSecond};
+
+    static_assert(Config::minHeight > 0 && Config::minHeight < Config::height, "minHeight must be between 0 and height");
+};
+
+#ifndef RIG
+#define RIG MiniEclipse
+#endif
+
+using Active = Derived<RIG>;
+}
+
+#endif
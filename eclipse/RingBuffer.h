@@ -0,0 +1,82 @@
+#ifndef RingBuffer_h
+#define RingBuffer_h
+
+#include <Arduino.h>
+
+/**
+ * @brief Fixed-capacity queue for exactly one producer and one consumer,
+ * such as loop() and an interrupt, that never allocates.
+ *
+ * Neither side has to turn interrupts off. Each index is a single byte
+ * written by only one side, and an item is only published by moving the
+ * tail once it has been copied in completely.
+ *
+ * One slot is kept empty to tell full from empty, so N slots hold N - 1 items.
+ */
+template<class T, uint8_t N>
+class RingBuffer {
+    static_assert(N >= 2 && N <= 128, "Indices must fit in a byte");
+
+public:
+    // Producer side
+    bool push(const T& item) {
+        const uint8_t next = advance(tail);
+        if (next == head) {
+            return false;
+        }
+        items[tail] = item;
+        barrier();
+        tail = next;
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        if (head == tail) {
+            return false;
+        }
+        barrier();
+        item = items[head];
+        barrier();
+        head = advance(head);
+        return true;
+    }
+
+    uint8_t size() const {
+        return (tail + N - head) % N;
+    }
+
+    bool empty() const {
+        return head == tail;
+    }
+
+    bool full() const {
+        return advance(tail) == head;
+    }
+
+    static constexpr uint8_t capacity() {
+        return N - 1;
+    }
+
+    // Only safe while the consumer can't run, e.g. inside an atomic block.
+    void clear() {
+        head = tail;
+    }
+
+private:
+    static uint8_t advance(uint8_t i) {
+        return (i + 1) % N;
+    }
+
+    // The AVR is in order, so it's enough to stop the compiler reordering
+    // the copy around the index update.
+    static void barrier() {
+        asm volatile("" ::: "memory");
+    }
+
+    T items[N];
+    volatile uint8_t head {0};  // Next to pop; only the consumer writes it
+    volatile uint8_t tail {0};  // Next to fill; only the producer writes it
+};
+
+#endif
@@ -4,21 +4,74 @@
 namespace Scheduler{
 
 namespace {
-Time interval {Time::fromMinutes(0.02)};
-Time target {Time(0)};
+struct Task {
+    Callback callback;  // nullptr when the slot is free
+    time_t period;  // 0 for one-shot
+    time_t deadline;
+};
 
-namespace Tasks {
-    int clock = 0;  // For cycles
+Task tasks[capacity] {};  // By Id
+
+// Ids ordered as a binary min-heap on deadline, and where each one sits
+Id heap[capacity];
+uint8_t position[capacity];
+uint8_t count {0};
+
+bool earlier(uint8_t a, uint8_t b) {
+    return tasks[heap[a]].deadline < tasks[heap[b]].deadline;
+}
+
+void swap(uint8_t a, uint8_t b) {
+    const Id id = heap[a];
+    heap[a] = heap[b];
+    heap[b] = id;
+    position[heap[a]] = a;
+    position[heap[b]] = b;
+}
+
+void siftUp(uint8_t i) {
+    while (i > 0 && earlier(i, (i - 1) / 2)) {
+        swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void siftDown(uint8_t i) {
+    while (true) {
+        uint8_t first = i;
+        for (uint8_t child = 2 * i + 1; child <= 2 * i + 2 && child < count; child++) {
+            if (earlier(child, first)) {
+                first = child;
+            }
+        }
+        if (first == i) {
+            return;
+        }
+        swap(i, first);
+        i = first;
+    }
+}
+
+bool scheduled(Id id) {
+    return id >= 0 && id < capacity && tasks[id].callback;
+}
+
+time_t toSeconds(double minutes) {
+    return Time::fromMinutes(minutes).unixTime;
+}
+
+int clock = 0;  // For cycles
+}
 
-    Parser::Command printTime(Time time) {
-        Serial.print(time.unixTime);
+namespace Tasks {
+    Parser::Command printTime(Time now) {
+        Serial.print(now.unixTime);
         Serial.print(": ");
-        Serial.println(time);
+        Serial.println(now);
         return Parser::empty;
     }
 
-    Parser::Command makeSquare() {
-        constexpr int steps = 4;
+    Parser::Command makeSquare(Time) {
         auto command = Parser::empty;
         command.type = Parser::CommandType::Go;
         constexpr double length = 30;
@@ -34,11 +87,13 @@ namespace Tasks {
         return command;
     }
 }
-}
 
 void setTime(const String timeString) {
     Time::setTime(timeString);
-    target = Time::getNow();
+    // Equal deadlines keep the heap in order.
+    for (uint8_t i = 0; i < count; i++) {
+        tasks[heap[i]].deadline = Time::getRawNow();
+    }
 }
 
 void setZone(double offset) {
@@ -50,35 +105,80 @@ void init(const String timeString, double rate=1) {
     Time::setSpeed(rate);
 }
 
-void setInterval(double minutes) {
-    interval = Time::fromMinutes(minutes);
+Id add(Callback callback, double period, double delay) {
+    if (count >= capacity) {
+        return noTask;
+    }
+    Id id = 0;
+    while (tasks[id].callback) {
+        id++;
+    }
+
+    tasks[id] = Task{callback, toSeconds(period), Time::getRawNow() + toSeconds(delay)};
+    heap[count] = id;
+    position[id] = count;
+    count++;
+    siftUp(count - 1);
+    return id;
+}
+
+void remove(Id id) {
+    if (!scheduled(id)) {
+        return;
+    }
+    const uint8_t i = position[id];
+    tasks[id].callback = nullptr;
+    count--;
+    if (i < count) {
+        heap[i] = heap[count];
+        position[heap[i]] = i;
+        siftUp(i);
+        siftDown(i);
+    }
+}
+
+void setPeriod(Id id, double minutes) {
+    if (scheduled(id)) {
+        tasks[id].period = toSeconds(minutes);
+    }
+}
+
+void setNext(Id id, Time at) {
+    if (!scheduled(id)) {
+        return;
+    }
+    tasks[id].deadline = at.unixTime;
+    siftUp(position[id]);
+    siftDown(position[id]);
 }
 
 // Keeps pace until we reset with fetch()
 void run() {
     Time::update();
-    ready = target <= Time::getNow();
+    ready = count > 0 && tasks[heap[0]].deadline <= Time::getRawNow();
 }
 
 Parser::Command fetch() {
+    if (!ready) {
+        return Parser::empty;
+    }
+    ready = false;
+
     /**
-     * @brief [CHANGED] I considered whether to use the current
-     * time or the target time. I decided to keep it on
-     * the regular track of target += interval rather
-     * than having it be more "faithful" but irregular
-     * 
-     * Actually, so the system doesn't fall behind, we start 
-     * the interval from when we fetch.
+     * @brief So the system doesn't fall behind, each task's next
+     * period starts from when it's run rather than from its
+     * deadline.
      */
     const auto now = Time::getNow();
-    // const auto currentCommand = Tasks::printTime(now);
-    const auto currentCommand = Tasks::makeSquare();
-    if (ready) {
-        target = now + interval;
-        return currentCommand;
+    const Id id = heap[0];
+    const Callback callback = tasks[id].callback;
+    if (tasks[id].period > 0) {
+        tasks[id].deadline = now.unixTime + tasks[id].period;
+        siftDown(0);
     } else {
-        return Parser::empty;
+        remove(id);
     }
+    return callback(now);
 }
 
 bool ready {false};
@@ -3,22 +3,56 @@
 
 #include <Arduino.h>
 #include "Parser.h"
+#include "Time.h"
 
 namespace Scheduler{
-    // Initial implementation: simple long non-blocking loop.
+    // Tasks run in order of their deadlines, kept in a min-heap so checking
+    // for a due task is O(1) and rescheduling one is O(log n).
+    constexpr uint8_t capacity {8};
+
+    // Called when the task is due; the command it returns is executed
+    // (Parser::empty for none).
+    using Callback = Parser::Command (*)(Time now);
+
+    // Identifies a task, or noTask when there's no room for it.
+    using Id = int8_t;
+    constexpr Id noTask {-1};
+
     void init(const String timeString, double rate=1);
 
+    // Jumping the clock makes every task due at once.
     void setTime(const String timeString);
 
     void setZone(double offset);
 
-    void setInterval(double minutes);
+    /**
+     * @brief Run callback every period minutes, or just once if period is
+     * 0, starting after delay minutes.
+     *
+     */
+    Id add(Callback callback, double period, double delay=0);
+
+    void remove(Id id);
+
+    // For tasks that work out their own pace; applies from the next run.
+    void setPeriod(Id id, double minutes);
+
+    // Move the task's next run, e.g. from inside its own callback.
+    void setNext(Id id, Time at);
 
     void run();
 
+    // Runs the earliest due task, and schedules its next run.
     Parser::Command fetch();
 
     extern bool ready;  // extern necessary to avoid linkage error
+
+    namespace Tasks {
+        Parser::Command printTime(Time now);
+
+        // Demo: trace a square, a corner per run
+        Parser::Command makeSquare(Time now);
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
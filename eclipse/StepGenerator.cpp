@@ -0,0 +1,235 @@
+#include "StepGenerator.h"
+
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "RingBuffer.h"
+
+namespace StepGenerator {
+namespace {
+using Config = Rig::Active;
+
+// Left and right. Pins 0-7 sit on PORTD on the Uno, so the pin number is
+// also the bit to toggle. Copied element by element: binding the rig's
+// arrays by reference would need out-of-line definitions before C++17.
+constexpr uint8_t stepPins[2] {Config::stepPins[0], Config::stepPins[1]};
+constexpr uint8_t dirPins[2] {Config::dirPins[0], Config::dirPins[1]};
+static_assert(stepPins[0] < 8 && stepPins[1] < 8 && dirPins[0] < 8 && dirPins[1] < 8, "Step and direction pins must be on PORTD");
+
+constexpr bool invertDirection[2] {Config::invertDirection[0], Config::invertDirection[1]};
+
+// Below this the interrupt can't keep up (about 20k steps per second).
+constexpr unsigned long minInterval {100};
+constexpr unsigned long maxInterval {ticksPerSecond * 60};
+
+// loop() produces and the interrupt consumes.
+RingBuffer<Segment, 8> queue;
+
+struct Axis {
+    long count;  // Steps in the current segment
+    long error;  // Bresenham accumulator against the master count
+    int8_t direction;
+};
+
+Axis axes[2];
+long masterCount {0};  // Ticks in the current segment; the longer axis steps on each
+long remaining {0};  // Ticks left in the current segment
+unsigned long interval {0};
+unsigned long wait {0};  // Ticks still to wait before the next step
+
+bool endsMotion {true};  // The segment being stepped is the last one planned
+
+volatile long positions[2] {0, 0};
+volatile bool running {false};
+volatile unsigned int underrunCount {0};
+
+void setInterrupt(bool on) {
+    if (on) {
+        TIMSK1 |= _BV(OCIE1A);
+    } else {
+        TIMSK1 &= ~_BV(OCIE1A);
+    }
+}
+
+void loadAxis(uint8_t i, long steps) {
+    Axis& axis = axes[i];
+    axis.count = labs(steps);
+    axis.direction = steps < 0 ? -1 : 1;
+
+    const bool high = (steps >= 0) != invertDirection[i];
+    if (high) {
+        PORTD |= _BV(dirPins[i]);
+    } else {
+        PORTD &= ~_BV(dirPins[i]);
+    }
+}
+
+// Called with interrupts off, either from the ISR or an atomic block.
+void loadNext() {
+    Segment segment;
+    while (queue.pop(segment)) {
+        if (segment.steps.left || segment.steps.right) {
+            loadAxis(0, segment.steps.left);
+            loadAxis(1, segment.steps.right);
+            masterCount = max(axes[0].count, axes[1].count);
+            // Starting from zero puts the last step of the shorter axis on
+            // the final tick, so both strings arrive together.
+            axes[0].error = axes[1].error = 0;
+            remaining = masterCount;
+            interval = segment.interval;
+            wait = 0;
+            endsMotion = segment.last;
+
+            if (!running) {
+                // Leave a little time for the direction pins to settle.
+                OCR1A = TCNT1 + minInterval;
+                setInterrupt(true);
+                running = true;
+            }
+            return;
+        }
+    }
+    if (running && !endsMotion) {
+        underrunCount++;
+    }
+    setInterrupt(false);
+    running = false;
+}
+
+// Split long waits in halves of the register so no chunk is too short to catch.
+uint16_t nextChunk() {
+    const uint16_t chunk = wait > 0xFFFF ? 0x8000 : wait;
+    wait -= chunk;
+    return chunk;
+}
+
+/**
+ * @brief Step whichever axes are due on this tick, then return the ticks
+ * until the interrupt next needs to run, or 0 once the segment is done.
+ *
+ * Intervals longer than the 16-bit compare register are waited out in chunks.
+ */
+uint16_t service() {
+    if (!wait) {
+        uint8_t bits = 0;
+        for (uint8_t i = 0; i < 2; i++) {
+            Axis& axis = axes[i];
+            axis.error += axis.count;
+            if (axis.error >= masterCount) {
+                axis.error -= masterCount;
+                bits |= _BV(stepPins[i]);
+                positions[i] += axis.direction;
+            }
+        }
+        PORTD |= bits;
+        remaining--;
+        wait = interval;
+        // The bookkeeping around the pulse keeps it well past the driver's minimum width.
+        PORTD &= ~bits;
+
+        if (!remaining) {
+            return 0;
+        }
+    }
+    return nextChunk();
+}
+}
+
+void init() {
+    for (uint8_t i = 0; i < 2; i++) {
+        pinMode(stepPins[i], OUTPUT);
+        pinMode(dirPins[i], OUTPUT);
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        TCCR1A = 0;  // Normal mode; the compare register walks along the free-running count
+        TCCR1B = _BV(CS11);
+        TIMSK1 = 0;
+    }
+}
+
+bool push(Segment segment) {
+    if (!queue.push(segment)) {
+        return false;
+    }
+    if (!running) {
+        // Only starting from idle needs the interrupt held off.
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            if (!running) {
+                loadNext();
+            }
+        }
+    }
+    return true;
+}
+
+bool full() {
+    return queue.full();
+}
+
+uint8_t queued() {
+    return queue.size();
+}
+
+unsigned int underruns() {
+    unsigned int count;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        count = underrunCount;
+    }
+    return count;
+}
+
+void clear() {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        queue.clear();
+        remaining = 0;
+        setInterrupt(false);
+        running = false;
+    }
+}
+
+bool idle() {
+    return !running;
+}
+
+Steps getSteps() {
+    Steps steps;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        steps.left = positions[0];
+        steps.right = positions[1];
+    }
+    return steps;
+}
+
+void setSteps(Steps steps) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        positions[0] = steps.left;
+        positions[1] = steps.right;
+    }
+}
+
+unsigned long intervalFor(double stepsPerSecond) {
+    const double rate = fabs(stepsPerSecond);
+    // Also catches NaN, which fails every comparison.
+    if (!(rate * maxInterval > ticksPerSecond)) {
+        return maxInterval;
+    }
+    const double ticks = ticksPerSecond / rate;
+    return ticks < minInterval ? minInterval : static_cast<unsigned long>(ticks);
+}
+}
+
+ISR(TIMER1_COMPA_vect) {
+    using namespace StepGenerator;
+    uint16_t next = service();
+    if (!next) {
+        loadNext();
+        if (!running) {
+            return;
+        }
+        // Back-to-back segments keep their cadence across the boundary.
+        wait = interval;
+        next = nextChunk();
+    }
+    OCR1A += next;
+}
@@ -0,0 +1,77 @@
+#ifndef StepGenerator_h
+#define StepGenerator_h
+
+#include <Arduino.h>
+#include "Lengths.h"
+
+// Emits the step and direction pulses from the Timer1 compare interrupt
+// so that pulse timing no longer depends on how long loop() takes.
+//
+// Both motors share one master step clock. Every tick the longer axis steps
+// and the shorter one steps whenever its Bresenham error overflows, so both
+// finish a segment on the same tick and the blocker follows a straight line
+// in string space.
+namespace StepGenerator {
+using Lengths::Steps;
+
+// Timer1 runs with a prescaler of 8.
+constexpr unsigned long ticksPerSecond {F_CPU / 8};
+
+/**
+ * @brief A run of steps on both motors at a constant master step rate.
+ *
+ */
+struct Segment {
+    Steps steps;  // Relative to the end of the previous segment
+    unsigned long interval;  // Timer ticks between steps of the longer axis
+    bool last;  // Motion is meant to stop here, so running dry isn't an underrun
+};
+static_assert(__is_trivially_copyable(Segment), "Segments are copied in and out of the interrupt's queue");
+
+void init();
+
+/**
+ * @brief Queue a segment behind the ones already pending. Safe to call
+ * while the interrupt is running.
+ *
+ * @return false if the queue is full.
+ */
+bool push(Segment segment);
+
+bool full();
+
+// Segments waiting behind the one being stepped
+uint8_t queued();
+
+/**
+ * @brief How many times the queue ran dry in the middle of motion, which
+ * means loop() didn't keep up.
+ *
+ */
+unsigned int underruns();
+
+/**
+ * @brief Drop every pending segment and stop after the step in progress.
+ *
+ */
+void clear();
+
+bool idle();
+
+Steps getSteps();
+
+/**
+ * @brief Only meaningful while idle; otherwise the interrupt keeps counting
+ * from the old position.
+ *
+ */
+void setSteps(Steps steps);
+
+/**
+ * @brief Convert a step rate (sign ignored) into timer ticks between steps.
+ *
+ */
+unsigned long intervalFor(double stepsPerSecond);
+}
+
+#endif
@@ -32,10 +32,29 @@ SunModel::SunModel(const Location _location, const SolarAngles _windowOffset):
         windowOffset(_windowOffset)
     {}
 
+void SunModel::setMethod(Method _method) {
+        method = _method;
+}
+
 SunModel::SolarAngles SunModel::anglesAt(Time time) const {
-        auto raw = rawAngles(time);
-        auto adjusted = adjustForWindow(raw);
-        return adjusted;
+        switch (method) {
+            case Method::Exact:
+            return adjustForWindow(rawAngles(time));
+
+            case Method::Fitted:
+            return adjustForWindow(fittedAngles(time));
+
+            default:
+            return adjustForWindow(cachedAngles(time));
+        }
+}
+
+double SunModel::fitError() const {
+        return fit.maxError;
+}
+
+SunModel::SolarAngles SunModel::exactAnglesAt(Time time) const {
+        return adjustForWindow(rawAngles(time));
 }
 
 SunModel::SolarAngles SunModel::rawAngles(Time time) const {
@@ -50,6 +69,190 @@ SunModel::SolarAngles SunModel::rawAngles(Time time) const {
         return SolarAngles{azimuth, altitude};
 }
 
+namespace {
+// Days from 1970 to the start of 1 January 2000, the J2000 epoch's day
+constexpr long j2000Day {10957};
+
+// Signed, since TimeLib's time_t is unsigned on AVR
+long secondsBetween(time_t from, time_t to) {
+    return static_cast<long>(to - from);
+}
+
+// Atmospheric refraction at the apparent elevation, in degrees, as
+// SolarCalculator figures it
+double refraction(double elevation) {
+    if (elevation > 85) {
+        return 0;
+    }
+    const double t = tan(radians(elevation));
+    double arcSeconds;
+    if (elevation > 5) {
+        arcSeconds = 58.1 / t - 0.07 / (t * t * t) + 0.000086 / (t * t * t * t * t);
+    } else if (elevation > -0.575) {
+        arcSeconds = 1735 + elevation * (-518.2 + elevation * (103.4 + elevation * (-12.79 + elevation * 0.711)));
+    } else {
+        arcSeconds = -20.772 / t;
+    }
+    return arcSeconds / 3600;
+}
+}
+
+void SunModel::fillEphemeris(time_t day) const {
+        double ascension, declination, distance;
+        double nextAscension, nextDeclination;
+        calcEquatorialCoordinates(day, ascension, declination, distance);
+        calcEquatorialCoordinates(day + SECS_PER_DAY, nextAscension, nextDeclination, distance);
+
+        // Whole days keep the sidereal time exact even in single precision:
+        // 360.98564736629 degrees a day is a whole turn plus the remainder.
+        const long days = static_cast<long>(day / SECS_PER_DAY) - j2000Day;
+        const double siderealTime = fmod(99.967794687 + 0.98564736629 * days, 360);
+
+        ephemeris = Ephemeris{
+            day,
+            ascension,
+            fmod(nextAscension - ascension + 540, 360) - 180,  // Across 0h at the March equinox
+            declination,
+            nextDeclination - declination,
+            siderealTime};
+}
+
+SunModel::SolarAngles SunModel::cachedAngles(Time time) const {
+        const time_t day = time.unixTime - time.unixTime % SECS_PER_DAY;
+        if (day != ephemeris.day) {
+            fillEphemeris(day);
+        }
+
+        const double fraction = static_cast<double>(time.unixTime - day) / SECS_PER_DAY;
+        const double ascension = ephemeris.rightAscension + ephemeris.ascensionPerDay * fraction;
+        const double declination = radians(ephemeris.declination + ephemeris.declinationPerDay * fraction);
+        const double siderealTime = ephemeris.siderealTime + 360.98564736629 * fraction;
+        const double hourAngle = radians(siderealTime + location.longitude - ascension);
+
+        const double latitude = radians(location.latitude);
+        const double sinDeclination = sin(declination);
+        const double cosDeclination = cos(declination);
+        const double cosHourAngle = cos(hourAngle);
+
+        const double azimuth = 180 + degrees(atan2(
+            sin(hourAngle),
+            cosHourAngle * sin(latitude) - sinDeclination / cosDeclination * cos(latitude)));
+        const double altitude = degrees(asin(
+            sin(latitude) * sinDeclination + cos(latitude) * cosDeclination * cosHourAngle));
+
+        return SolarAngles{azimuth, altitude + refraction(altitude)};
+}
+
+namespace {
+// Fits span the time the sun is at least this high, in degrees. Lower down,
+// refraction bends so sharply that no short series follows it.
+constexpr double fitHorizon {2};
+
+// Clenshaw's recurrence, the Horner's rule of Chebyshev series: two
+// multiply-adds a term
+double chebyshev(const float* coefficients, uint8_t terms, double x) {
+    double next = 0;
+    double afterNext = 0;
+    for (uint8_t j = terms - 1; j >= 1; j--) {
+        const double current = coefficients[j] + 2 * x * next - afterNext;
+        afterNext = next;
+        next = current;
+    }
+    return coefficients[0] + x * next - afterNext;
+}
+
+// Nearest to previous, by whole turns, so a fit never sees a jump
+double unwrap(double angle, double previous) {
+    return angle - 360 * round((angle - previous) / 360);
+}
+}
+
+void SunModel::makeFit(Time time) const {
+        const time_t day = time.unixTime - time.unixTime % SECS_PER_DAY;
+        if (day != ephemeris.day) {
+            fillEphemeris(day);
+        }
+
+        // Solar noon is when the hour angle comes round to 0, at this many
+        // degrees a day.
+        const double turn = 360.98564736629 - ephemeris.ascensionPerDay;
+        const double midnightHourAngle = ephemeris.siderealTime + location.longitude - ephemeris.rightAscension;
+        const double noon = fmod(fmod(-midnightHourAngle, 360) + 360, 360) / turn;
+        time_t transit = day + static_cast<long>(noon * SECS_PER_DAY);
+        const long fromNoon = secondsBetween(transit, time.unixTime);
+        if (fromNoon > static_cast<long>(SECS_PER_DAY / 2)) {
+            transit += SECS_PER_DAY;
+        } else if (fromNoon < -static_cast<long>(SECS_PER_DAY / 2)) {
+            transit -= SECS_PER_DAY;
+        }
+
+        const double latitude = radians(location.latitude);
+        const double declination = radians(ephemeris.declination
+            + ephemeris.declinationPerDay * secondsBetween(day, transit) / SECS_PER_DAY);
+        const double cosRise = (sin(radians(fitHorizon)) - sin(latitude) * sin(declination))
+            / (cos(latitude) * cos(declination));
+        const double riseHourAngle = cosRise >= 1 ? 0 : cosRise <= -1 ? 180 : degrees(acos(cosRise));
+        const long half = riseHourAngle / turn * SECS_PER_DAY;
+
+        fit.transit = transit;
+        fit.rise = transit - half;
+        fit.set = transit + half;
+        fit.maxError = -1;
+        if (half == 0) {
+            return;  // The sun never gets that high
+        }
+
+        // Sampled from the last node to the first, so in time order
+        double azimuths[fitTerms];
+        double altitudes[fitTerms];
+        double previous = 180;
+        for (uint8_t k = 0; k < fitTerms; k++) {
+            const double x = -cos(PI * (k + 0.5) / fitTerms);
+            const auto angles = cachedAngles(Time(transit + static_cast<long>(x * half)));
+            azimuths[k] = previous = unwrap(angles.azimuth, previous);
+            altitudes[k] = angles.altitude;
+        }
+
+        for (uint8_t j = 0; j < fitTerms; j++) {
+            double azimuth = 0;
+            double altitude = 0;
+            for (uint8_t k = 0; k < fitTerms; k++) {
+                // T_j at the node, cos(j * acos(x)), counting nodes from the other end
+                const double weight = cos(PI * j * (fitTerms - k - 0.5) / fitTerms);
+                azimuth += azimuths[k] * weight;
+                altitude += altitudes[k] * weight;
+            }
+            const double scale = (j == 0 ? 1.0 : 2.0) / fitTerms;
+            fit.azimuth[j] = azimuth * scale;
+            fit.altitude[j] = altitude * scale;
+        }
+
+        // Check halfway between the nodes and at the ends, where it's worst.
+        constexpr uint8_t checks {2 * fitTerms + 1};
+        double worst = 0;
+        for (uint8_t i = 0; i < checks; i++) {
+            const double x = -1 + 2.0 * i / (checks - 1);
+            const auto exact = cachedAngles(Time(transit + static_cast<long>(x * half)));
+            const double azimuth = chebyshev(fit.azimuth, fitTerms, x);
+            worst = max(worst, fabs(unwrap(exact.azimuth, azimuth) - azimuth));
+            worst = max(worst, fabs(exact.altitude - chebyshev(fit.altitude, fitTerms, x)));
+        }
+        fit.maxError = worst;
+}
+
+SunModel::SolarAngles SunModel::fittedAngles(Time time) const {
+        if (labs(secondsBetween(fit.transit, time.unixTime)) > static_cast<long>(SECS_PER_DAY / 2)) {
+            makeFit(time);
+        }
+        if (time.unixTime < fit.rise || fit.set < time.unixTime
+            || fit.maxError < 0 || fit.maxError > maxFitError) {
+            return cachedAngles(time);
+        }
+
+        const double x = static_cast<double>(secondsBetween(fit.transit, time.unixTime)) / (fit.set - fit.transit);
+        return SolarAngles{chebyshev(fit.azimuth, fitTerms, x), chebyshev(fit.altitude, fitTerms, x)};
+}
+
 SunModel::SolarAngles SunModel::adjustForWindow(SolarAngles raw) const {
         return raw - windowOffset;
 }
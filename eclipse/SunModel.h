@@ -30,15 +30,82 @@ public:
 
     SunModel(const Location _location, const SolarAngles _windowOffset);
 
+    // How anglesAt() works the angles out
+    enum class Method : uint8_t {
+        Exact,  // SolarCalculator's full series every call
+        Cached,  // A few trig calls from the day's ephemeris
+        Fitted,  // A few multiply-adds from the day's fit while the sun is up and the fit is good; Cached otherwise
+    };
+
+    void setMethod(Method _method);
+
     /**
      * @brief Return the angles associated with the time.
      * 
+     * By default the sun's place among the stars is worked out once per UTC
+     * day, so this takes a few trig calls rather than SolarCalculator's full
+     * series (see Method).
+     * 
      * @param time 
      * @return SolarAngles 
      */
     SolarAngles anglesAt(Time time) const;
 
+    /**
+     * @brief Worst error of the latest daily fit against the cached path,
+     * in degrees, measured when it was made; negative before the first.
+     * Fits worse than maxFitError aren't used.
+     * 
+     */
+    double fitError() const;
+
+    // About 0.06 inches of shadow seen from 35 inches back
+    static constexpr double maxFitError {0.1};
+
+    // As anglesAt(), but straight from SolarCalculator every call; kept to check against
+    SolarAngles exactAnglesAt(Time time) const;
+
 private:
+    /**
+     * @brief What barely changes over a day, at its first and last UTC
+     * midnights, to interpolate between. Angles in degrees.
+     * 
+     */
+    struct Ephemeris {
+        time_t day;  // The UTC midnight it starts at, or 1 (never a midnight) before the first fill
+        double rightAscension;
+        double ascensionPerDay;
+        double declination;
+        double declinationPerDay;
+        double siderealTime;  // Greenwich mean, at midnight
+    };
+
+    // Filled by anglesAt(), which is otherwise const
+    mutable Ephemeris ephemeris {1, 0, 0, 0, 0, 0};
+
+    static constexpr uint8_t fitTerms {12};
+
+    /**
+     * @brief Chebyshev series for the raw angles while the sun is up, from
+     * rise to set, in time scaled to [-1, 1] over that span. Fitted at the
+     * Chebyshev nodes, so each coefficient is a single sum.
+     * 
+     * Azimuth swings fast around noon when the sun is high, so near
+     * midsummer at mid latitudes the fit misses maxFitError and goes unused.
+     * 
+     */
+    struct DailyFit {
+        time_t transit;  // Solar noon it's around, or 0 before the first fit
+        time_t rise;
+        time_t set;
+        float azimuth[fitTerms];
+        float altitude[fitTerms];
+        float maxError;
+    };
+
+    Method method {Method::Cached};
+    mutable DailyFit fit {0, 0, 0, {}, {}, -1};
+
     const Location location;
 
     // Solar angles corresponding to the perpendicular to the window.
@@ -52,6 +119,17 @@ private:
      */
     SolarAngles rawAngles(Time time) const;
 
+    // As rawAngles(), from the day's Ephemeris
+    SolarAngles cachedAngles(Time time) const;
+
+    void fillEphemeris(time_t day) const;
+
+    // Refit for the solar day nearest the time
+    void makeFit(Time time) const;
+
+    // As rawAngles(), from the fit, else from cachedAngles()
+    SolarAngles fittedAngles(Time time) const;
+
     SolarAngles adjustForWindow(SolarAngles raw) const;
 };
 
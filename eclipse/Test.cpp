@@ -0,0 +1,560 @@
+#include "Test.h"
+
+#include <Arduino.h>
+#include "Binary.h"
+#include "Kinematics.h"
+#include "Lengths.h"
+#include "Parser.h"
+#include "Rig.h"
+#include "SunModel.h"
+#include "Tracker.h"
+
+// Bounds of the heap from avr-libc's malloc
+extern char __heap_start;
+extern char* __brkval;
+
+namespace Test {
+using namespace Lengths;
+namespace {
+constexpr int samples {24};
+
+// Benchmarked results land here so the optimizer can't drop the calls.
+volatile uint8_t sink {0};
+
+// Poses spread over the middle of the workspace
+TruePosition samplePose(int i) {
+    return TruePosition(width * (i % 6 + 1) / 7, minHeight + 6 * (i / 6 + 1));
+}
+
+TotalLengths lengthsAt(TruePosition truePosition) {
+    const Radial radial(truePosition);
+    const Tangential tangential(radial);
+    return TotalLengths(truePosition, radial, tangential);
+}
+
+void printResult(const char* name, unsigned long micros, double perCall) {
+    Serial.print(name);
+    Serial.print(": ");
+    Serial.print(static_cast<double>(micros) / samples);
+    Serial.print(" us per call");
+    if (perCall >= 0) {
+        Serial.print(", ");
+        Serial.print(perCall);
+    }
+    Serial.println();
+}
+
+// Exact Newton inverse against the old radius * pi/4 approximation
+void inverseBenchmark() {
+    TotalLengths lengths[samples];
+    for (int i = 0; i < samples; i++) {
+        lengths[i] = lengthsAt(samplePose(i));
+    }
+
+    double worstError = 0;
+    auto began = micros();
+    for (int i = 0; i < samples; i++) {
+        const TruePosition estimate(Radial(approximateTangential(lengths[i])));
+        const auto actual = samplePose(i);
+        worstError = max(worstError, sqrt(sq(estimate.x - actual.x) + sq(estimate.y - actual.y)));
+    }
+    printResult("Approximate", micros() - began, -1);
+    Serial.print("Approximate worst error (in): ");
+    Serial.println(worstError, 4);
+
+    unsigned int iterations = 0;
+    began = micros();
+    for (int i = 0; i < samples; i++) {
+        const TruePosition exact(lengths[i]);
+        iterations += inverseIterations;
+    }
+    printResult("Newton from approximate, iterations", micros() - began, static_cast<double>(iterations) / samples);
+
+    // What getTruePosition() sees: the last pose is a few steps away.
+    iterations = 0;
+    began = micros();
+    for (int i = 0; i < samples; i++) {
+        const auto nearby = samplePose(i) + TruePosition(0.01, -0.01);
+        const TruePosition exact(lengths[i], nearby);
+        iterations += inverseIterations;
+    }
+    printResult("Newton from last pose, iterations", micros() - began, static_cast<double>(iterations) / samples);
+}
+
+// Bilinear lookup in the flash table against the full trig chain
+void lookupBenchmark() {
+    TotalLengths exact[samples];
+    auto began = micros();
+    for (int i = 0; i < samples; i++) {
+        exact[i] = lengthsAt(samplePose(i));
+    }
+    printResult("Exact lengths", micros() - began, -1);
+
+    double worstError = 0;
+    double worstBound = 0;
+    began = micros();
+    for (int i = 0; i < samples; i++) {
+        const auto looked = lookupLengths(samplePose(i), 1);
+        worstError = max(worstError, max(fabs(looked.left - exact[i].left), fabs(looked.right - exact[i].right)));
+    }
+    printResult("Table lengths", micros() - began, -1);
+
+    for (int i = 0; i < samples; i++) {
+        worstBound = max(worstBound, lookupError(samplePose(i)));
+    }
+    Serial.print("Table worst error (in): ");
+    Serial.print(worstError, 4);
+    Serial.print(", cell bound ");
+    Serial.println(worstBound, 4);
+}
+
+struct Chain {
+    double radial[2];
+    double tangential[2];
+    double total[2];
+    double roundTrip[2];  // The pose back from the radials
+};
+
+// Radials, tangents and totals for both strings, then the pose back from
+// the radials, all in the scalar T.
+template<class T>
+Chain runChain(TruePosition truePosition) {
+    const T horizontal[2] {T(truePosition.x), T(width - truePosition.x)};
+    Chain out;
+    T radial[2];
+    for (int i = 0; i < 2; i++) {
+        radial[i] = Kinematics::hypotenuse<T>(horizontal[i], truePosition.y);
+        const T tangential = Kinematics::leg<T>(radial[i], radius);
+        const T total = Kinematics::totalLength<T>(horizontal[i], truePosition.y, radial[i], tangential, radius);
+        out.radial[i] = static_cast<double>(radial[i]);
+        out.tangential[i] = static_cast<double>(tangential);
+        out.total[i] = static_cast<double>(total);
+    }
+    const T y = Kinematics::offset<T>(radial[0], radial[1], width);
+    out.roundTrip[0] = static_cast<double>(Kinematics::leg<T>(radial[0], y));
+    out.roundTrip[1] = static_cast<double>(y);
+    return out;
+}
+
+double worstOf(const double (&first)[2], const double (&second)[2]) {
+    return max(fabs(first[0] - second[0]), fabs(first[1] - second[1]));
+}
+
+// One scalar backend against double, with the errors in microsteps
+template<class T>
+void backendBenchmark(const char* name) {
+    double errors[4] {0, 0, 0, 0};
+    unsigned long elapsed = 0;
+    for (int i = 0; i < samples; i++) {
+        const auto reference = runChain<double>(samplePose(i));
+        const auto began = micros();
+        const auto chain = runChain<T>(samplePose(i));
+        elapsed += micros() - began;
+
+        errors[0] = max(errors[0], worstOf(chain.radial, reference.radial));
+        errors[1] = max(errors[1], worstOf(chain.tangential, reference.tangential));
+        errors[2] = max(errors[2], worstOf(chain.total, reference.total));
+        errors[3] = max(errors[3], worstOf(chain.roundTrip, reference.roundTrip));
+    }
+
+    printResult(name, elapsed, -1);
+    const char* stages[4] {"radial", "tangential", "total", "round trip"};
+    Serial.print("  worst microsteps off:");
+    for (int i = 0; i < 4; i++) {
+        Serial.print(" ");
+        Serial.print(stages[i]);
+        Serial.print(" ");
+        Serial.print(errors[i] * Rig::Active::stepsPerInch, 3);
+    }
+    Serial.println();
+}
+
+// Poses to steps one at a time through the constructors, then all at once
+void batchBenchmark() {
+    double x[samples];
+    double y[samples];
+    int32_t left[samples];
+    int32_t right[samples];
+    for (int i = 0; i < samples; i++) {
+        x[i] = samplePose(i).x;
+        y[i] = samplePose(i).y;
+    }
+
+    constexpr double stepsPerInch {Rig::Active::stepsPerInch};
+    auto began = micros();
+    for (int i = 0; i < samples; i++) {
+        const auto lengths = lengthsAt(TruePosition(x[i], y[i]));
+        left[i] = lround(lengths.left * stepsPerInch);
+        right[i] = lround(lengths.right * stepsPerInch);
+    }
+    const auto scalar = micros() - began;
+    for (int i = 0; i < samples; i++) {
+        sink = sink + static_cast<uint8_t>(left[i] ^ right[i]);
+    }
+
+    began = micros();
+    toSteps(x, y, samples, left, right);
+    const auto batch = micros() - began;
+    for (int i = 0; i < samples; i++) {
+        sink = sink + static_cast<uint8_t>(left[i] ^ right[i]);
+    }
+
+    printResult("One at a time", scalar, -1);
+    printResult("Batch", batch, -1);
+    Serial.print("Points per second: ");
+    Serial.print(samples * 1e6 / max(scalar, 1UL), 0);
+    Serial.print(" one at a time, ");
+    Serial.print(samples * 1e6 / max(batch, 1UL), 0);
+    Serial.println(" batch");
+}
+
+// Free memory between the heap and the stack is painted before a run, so
+// the heap's high-water mark shows as the highest byte written since.
+constexpr uint8_t paint {0xA5};
+constexpr size_t stackMargin {128};  // Left for this function's own stack
+
+char* heapTop() {
+    return __brkval ? __brkval : &__heap_start;
+}
+
+char* paintFreeMemory() {
+    char* const from = heapTop();
+    char* const to = reinterpret_cast<char*>(SP) - stackMargin;
+    for (char* p = from; p < to; p++) {
+        *p = paint;
+    }
+    return from;
+}
+
+// Only the lower half is checked, since the stack grows down into the top.
+size_t heapReach(char* from) {
+    char* const to = from + (reinterpret_cast<char*>(SP) - stackMargin - from) / 2;
+    char* highest = from;
+    for (char* p = from; p < to; p++) {
+        if (*p != static_cast<char>(paint)) {
+            highest = p + 1;
+        }
+    }
+    return highest - from;
+}
+
+// The String parser against the in-place one, over a few typical lines
+void parseBenchmark() {
+    const char* lines[3] {"go 12.5 30", "settime 2023.02.06 19:52 -5", "status"};
+    constexpr int repeats {samples / 3};
+    char buffer[32];
+
+    char* from = paintFreeMemory();
+    auto began = micros();
+    for (int i = 0; i < samples; i++) {
+        const auto command = Parser::parse(String(lines[i / repeats]));
+        sink = sink + static_cast<uint8_t>(command.type);
+    }
+    printResult("String parse", micros() - began, -1);
+    Serial.print("  heap reached (bytes): ");
+    Serial.println(heapReach(from));
+
+    from = paintFreeMemory();
+    began = micros();
+    for (int i = 0; i < samples; i++) {
+        strcpy(buffer, lines[i / repeats]);
+        const auto command = Parser::parse(buffer);
+        sink = sink + static_cast<uint8_t>(command.type);
+    }
+    printResult("In-place parse", micros() - began, -1);
+    Serial.print("  heap reached (bytes): ");
+    Serial.println(heapReach(from));
+}
+
+// Frames through the device's own encoder and back, against the same
+// commands as text lines
+void binaryBenchmark() {
+    using Parser::CommandType;
+    const Parser::Command commands[3] {
+        Parser::Command(CommandType::GoStep, "", 12345, 23456),
+        Parser::Command(CommandType::Go, "", 12.375, 30.125),
+        Parser::Command(CommandType::Status, "", 0, 0),
+    };
+    const char* lines[3] {"gostep 12345 23456", "go 12.375 30.125", "status"};
+    constexpr int repeats {samples / 3};
+
+    uint8_t frame[Binary::maxFrame + 1];
+    size_t frameBytes = 0;
+    size_t lineBytes = 0;
+    int mismatches = 0;
+    unsigned long elapsed = 0;
+    for (int i = 0; i < samples; i++) {
+        const auto& command = commands[i / repeats];
+        const size_t size = Binary::encode(command, frame);
+        frameBytes += size;
+        lineBytes += strlen(lines[i / repeats]) + 1;
+
+        auto decoded = Parser::empty;
+        const auto began = micros();
+        const bool ok = Binary::decode(frame, size - 1, decoded);
+        elapsed += micros() - began;
+        if (!ok || decoded.type != command.type || decoded.num1 != command.num1 || decoded.num2 != command.num2) {
+            mismatches++;
+        }
+    }
+    printResult("Frame decode", elapsed, -1);
+
+    char buffer[32];
+    elapsed = 0;
+    for (int i = 0; i < samples; i++) {
+        strcpy(buffer, lines[i / repeats]);
+        const auto began = micros();
+        const auto command = Parser::parse(buffer);
+        elapsed += micros() - began;
+        sink = sink + static_cast<uint8_t>(command.type);
+    }
+    printResult("Text parse", elapsed, -1);
+
+    // 10 bits a byte on the wire
+    Serial.print("Commands per second at 9600 baud: ");
+    Serial.print(960.0 * samples / lineBytes, 1);
+    Serial.print(" text, ");
+    Serial.print(960.0 * samples / frameBytes, 1);
+    Serial.println(" binary");
+    Serial.print("Loopback mismatches: ");
+    Serial.println(mismatches);
+}
+
+// Hashed keyword lookup against trying every keyword, over a mix of
+// valid and invalid ones
+void dispatchBenchmark() {
+    const char* words[8] {"go", "gostep", "status", "binary", "bogus", "stpo", "g", "getinchx"};
+    constexpr int rounds {samples / 8};
+
+    int mismatches = 0;
+    for (auto word : words) {
+        mismatches += Parser::lookup(word) != Parser::lookupLinear(word);
+    }
+
+    auto began = micros();
+    for (int r = 0; r < rounds; r++) {
+        for (auto word : words) {
+            sink = sink + static_cast<uint8_t>(Parser::lookupLinear(word));
+        }
+    }
+    printResult("Linear lookup", micros() - began, -1);
+
+    began = micros();
+    for (int r = 0; r < rounds; r++) {
+        for (auto word : words) {
+            sink = sink + static_cast<uint8_t>(Parser::lookup(word));
+        }
+    }
+    printResult("Hashed lookup", micros() - began, -1);
+    Serial.print("Disagreements: ");
+    Serial.println(mismatches);
+}
+
+// Tracking moves over the next day at a steady pace and with a drift
+// tolerance, and the furthest the shadow got from the blocker, checked
+// every minute in between. Only plans, so the live task is left alone.
+void trackingBenchmark() {
+    const double tolerances[2] {0, 0.25};
+    const time_t from = Time::getRawNow();
+
+    for (const double tolerance : tolerances) {
+        unsigned int moves = 0;
+        unsigned int misses = 0;
+        unsigned long planning = 0;
+        double worstError = 0;
+
+        Time now {from};
+        while (now.unixTime < from + SECS_PER_DAY) {
+            TruePosition blocker {0, 0};
+            Time next {0};
+            bool missed = false;
+            const auto began = micros();
+            const bool moving = Tracker::plan(now, tolerance, blocker, next, missed);
+            planning += micros() - began;
+            if (moving) {
+                moves++;
+                misses += missed;
+                for (time_t t = now.unixTime; t < next.unixTime; t += SECS_PER_MIN) {
+                    TruePosition shadow {0, 0};
+                    if (Tracker::project(Time(t), shadow)) {
+                        worstError = max(worstError, hypot(shadow.x - blocker.x, shadow.y - blocker.y));
+                    }
+                }
+            }
+            now = next;
+        }
+
+        Serial.print("Tolerance ");
+        Serial.print(tolerance);
+        Serial.print(": ");
+        Serial.print(moves);
+        Serial.print(" moves, ");
+        Serial.print(misses);
+        Serial.print(" misses, worst error (in) ");
+        Serial.print(worstError, 3);
+        Serial.print(", ms planning per move ");
+        Serial.println(moves ? planning / 1000.0 / moves : 0);
+    }
+}
+
+// Sun angles from the day's cached ephemeris against SolarCalculator's
+// full series every call, hourly over the coming day
+void ephemerisBenchmark() {
+    using Config = Rig::Active;
+    const SunModel model(Config::latitude, Config::longitude, Config::windowAzimuth, Config::windowAltitude);
+    const time_t from = Time::getRawNow();
+    constexpr unsigned long cyclesPerMicro {F_CPU / 1000000L};
+
+    auto began = micros();
+    model.anglesAt(Time(from));
+    Serial.print("Filling the day's cache (cycles): ");
+    Serial.println((micros() - began) * cyclesPerMicro);
+
+    began = micros();
+    for (int i = 0; i < samples; i++) {
+        model.exactAnglesAt(Time(from + i * SECS_PER_HOUR));
+    }
+    const auto exact = micros() - began;
+
+    // Split so every sample falls in the cache's day
+    const time_t day = from - from % SECS_PER_DAY;
+    began = micros();
+    for (int i = 0; i < samples; i++) {
+        model.anglesAt(Time(day + i * SECS_PER_HOUR));
+    }
+    const auto cached = micros() - began;
+
+    double worstAzimuth = 0;
+    double worstAltitude = 0;
+    for (int i = 0; i < samples; i++) {
+        const Time time(day + i * SECS_PER_HOUR);
+        const auto difference = model.anglesAt(time) - model.exactAnglesAt(time);
+        worstAzimuth = max(worstAzimuth, fabs(fmod(difference.azimuth + 540, 360) - 180));
+        worstAltitude = max(worstAltitude, fabs(difference.altitude));
+    }
+
+    Serial.print("Cycles per call: ");
+    Serial.print(exact * cyclesPerMicro / samples);
+    Serial.print(" exact, ");
+    Serial.print(cached * cyclesPerMicro / samples);
+    Serial.println(" cached");
+    Serial.print("Worst error (degrees) in azimuth, altitude: ");
+    Serial.print(worstAzimuth, 4);
+    Serial.print(", ");
+    Serial.println(worstAltitude, 4);
+}
+
+// The daily Chebyshev fit against the cached path it stands in for, every
+// half hour while the sun is up
+void fitBenchmark() {
+    using Config = Rig::Active;
+    SunModel fitted(Config::latitude, Config::longitude, Config::windowAzimuth, Config::windowAltitude);
+    SunModel cached(Config::latitude, Config::longitude, Config::windowAzimuth, Config::windowAltitude);
+    fitted.setMethod(SunModel::Method::Fitted);
+    constexpr unsigned long cyclesPerMicro {F_CPU / 1000000L};
+
+    const time_t from = Time::getRawNow();
+    auto began = micros();
+    fitted.anglesAt(Time(from));
+    Serial.print("Fitting the day (cycles): ");
+    Serial.println((micros() - began) * cyclesPerMicro);
+    Serial.print("Fit error when made (degrees): ");
+    Serial.println(fitted.fitError(), 4);
+
+    // Daylight within half a day of now, the span the fit covers
+    time_t times[samples];
+    int count = 0;
+    for (long offset = -12 * 3600L; offset < 12 * 3600L && count < samples; offset += 1800) {
+        const Time time(from + offset);
+        if (cached.anglesAt(time).altitude > 5) {
+            times[count++] = time.unixTime;
+        }
+    }
+    if (count == 0) {
+        Serial.println("No daylight to compare");
+        return;
+    }
+
+    began = micros();
+    for (int i = 0; i < count; i++) {
+        fitted.anglesAt(Time(times[i]));
+    }
+    const auto fit = micros() - began;
+    began = micros();
+    for (int i = 0; i < count; i++) {
+        cached.anglesAt(Time(times[i]));
+    }
+    const auto trig = micros() - began;
+
+    double worst = 0;
+    for (int i = 0; i < count; i++) {
+        const auto difference = fitted.anglesAt(Time(times[i])) - cached.anglesAt(Time(times[i]));
+        worst = max(worst, fabs(fmod(difference.azimuth + 540, 360) - 180));
+        worst = max(worst, fabs(difference.altitude));
+    }
+
+    Serial.print("Cycles per call: ");
+    Serial.print(fit * cyclesPerMicro / count);
+    Serial.print(" fitted, ");
+    Serial.print(trig * cyclesPerMicro / count);
+    Serial.println(" cached");
+    Serial.print("Worst error seen (degrees): ");
+    Serial.println(worst, 4);
+}
+
+// On AVR double is float, so double and float should match exactly there.
+void scalarBenchmark() {
+    backendBenchmark<double>("double");
+    backendBenchmark<float>("float");
+    backendBenchmark<Fixed>("Q16.16");
+}
+}
+
+void run(int testNumber) {
+    switch (testNumber) {
+        case 1:
+        inverseBenchmark();
+        break;
+
+        case 2:
+        lookupBenchmark();
+        break;
+
+        case 3:
+        scalarBenchmark();
+        break;
+
+        case 4:
+        batchBenchmark();
+        break;
+
+        case 5:
+        parseBenchmark();
+        break;
+
+        case 6:
+        binaryBenchmark();
+        break;
+
+        case 7:
+        dispatchBenchmark();
+        break;
+
+        case 8:
+        trackingBenchmark();
+        break;
+
+        case 9:
+        ephemerisBenchmark();
+        break;
+
+        case 10:
+        fitBenchmark();
+        break;
+
+        default:
+        Serial.println("No such test");
+        break;
+    }
+}
+}
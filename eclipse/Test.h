@@ -0,0 +1,10 @@
+#ifndef Test_h
+#define Test_h
+
+// On-device benchmarks, run with `test [testNumber]`. Each prints its own
+// timings, so the numbers come from the real MCU and its soft floats.
+namespace Test {
+void run(int testNumber);
+}
+
+#endif
@@ -0,0 +1,239 @@
+#include "Tracker.h"
+
+#include "MotorSystem.h"
+#include "Rig.h"
+#include "Scheduler.h"
+#include "SunModel.h"
+
+namespace Tracker {
+using namespace Lengths;
+
+namespace {
+using Config = Rig::Active;
+
+SunModel model {SunModel::Location{Config::latitude, Config::longitude},
+                SunModel::SolarAngles{Config::windowAzimuth, Config::windowAltitude}};
+
+double viewer[3] {Config::viewer[0], Config::viewer[1], Config::viewer[2]};
+
+// Lowest the sun may be, as in py/window.py, and furthest either angle may
+// be from the window's normal before the shadow runs off toward infinity.
+constexpr double minAltitude {-15};
+constexpr double maxAngle {85};
+
+// Roughly how far, in inches, the shadow moves between updates
+constexpr double stride {0.25};
+
+// Bounds on the interval, in minutes; at night the task checks at the longest.
+constexpr double minInterval {0.5};
+constexpr double maxInterval {10};
+
+// How far ahead to look to estimate the shadow's speed, in minutes
+constexpr double probe {1};
+
+// Drift allowed before moving, in inches; 0 to move at a pace instead
+double tolerance {0};
+
+// Finest a drift search narrows down when to move, in seconds
+constexpr time_t resolution {15};
+constexpr uint8_t maxGuesses {6};
+
+Scheduler::Id task {Scheduler::noTask};
+
+TruePosition target {0, 0};
+unsigned int moves {0};
+unsigned int misses {0};  // Moves after which the shadow outran tolerance within resolution
+
+bool reachable(TruePosition position) {
+    return 0 < position.x && position.x < Config::width
+           && Config::minHeight < position.y && position.y < Config::height;
+}
+
+// Minutes until the shadow has moved by about stride, going by its speed now
+double pace(Time now, TruePosition blocker) {
+    TruePosition ahead {0, 0};
+    if (!project(now + Time::fromMinutes(probe), ahead)) {
+        return minInterval;  // About to leave the window; follow it out closely
+    }
+    const double speed = hypot(ahead.x - blocker.x, ahead.y - blocker.y) / probe;
+    if (speed * maxInterval <= stride) {
+        return maxInterval;
+    }
+    return constrain(stride / speed, minInterval, maxInterval);
+}
+
+// How far the shadow is from origin at the time; out of reach counts as infinitely far
+double driftAt(time_t time, TruePosition origin) {
+    TruePosition shadow {0, 0};
+    if (!project(Time(time), shadow)) {
+        return INFINITY;
+    }
+    return hypot(shadow.x - origin.x, shadow.y - origin.y);
+}
+
+/**
+ * @brief The last time, to within resolution, before the shadow drifts
+ * limit from origin, looking up to maxInterval on; false if even
+ * resolution on is too late, in which case until is that anyway.
+ *
+ * Drift grows about linearly over minutes, so each guess scales the last
+ * by how far short of limit it fell; once one overshoots, bisection
+ * finds the crossing between it and the last one that didn't. That can be
+ * sooner than minInterval, which only paces the moves when there's no
+ * tolerance; a floor there would let the shadow drift past limit whenever
+ * it moves faster than limit per minInterval.
+ */
+bool reach(Time from, TruePosition origin, double limit, Time& until) {
+    const time_t earliest = from.unixTime + resolution;
+    const time_t latest = from.unixTime + Time::fromMinutes(maxInterval).unixTime;
+
+    time_t safe = from.unixTime;
+    time_t over = 0;
+    time_t guess = from.unixTime + Time::fromMinutes(probe).unixTime;
+    for (uint8_t i = 0; i < maxGuesses && !over; i++) {
+        guess = min(guess, latest);
+        const double drift = driftAt(guess, origin);
+        if (drift > limit) {
+            over = guess;
+        } else if (guess == latest) {
+            until = Time(latest);
+            return true;
+        } else {
+            safe = guess;
+            const time_t ahead = (guess - from.unixTime) * min(limit / max(drift, 1e-3), 4.0);
+            guess = from.unixTime + max(ahead, guess - from.unixTime + resolution);
+        }
+    }
+
+    while (over && over - safe > resolution) {
+        const time_t middle = safe + (over - safe) / 2;
+        if (driftAt(middle, origin) > limit) {
+            over = middle;
+        } else {
+            safe = middle;
+        }
+    }
+    until = Time(max(safe, earliest));
+    return safe >= earliest;
+}
+}
+
+void init() {
+    // Planning a move looks up the sun a dozen times.
+    model.setMethod(SunModel::Method::Fitted);
+    task = Scheduler::add(track, maxInterval);
+}
+
+void catchUp() {
+    if (task != Scheduler::noTask) {
+        Scheduler::setNext(task, Time::getNow());
+    }
+}
+
+bool setViewer(const char* text) {
+    char* rest = const_cast<char*>(text);
+    double read[3];
+    for (auto& value : read) {
+        char* start = rest;
+        value = strtod(start, &rest);
+        if (rest == start) {
+            return false;
+        }
+    }
+    if (read[2] <= 0) {
+        return false;
+    }
+
+    memcpy(viewer, read, sizeof(viewer));
+    catchUp();
+    return true;
+}
+
+bool project(Time time, TruePosition& blocker) {
+    const auto angles = model.anglesAt(time);
+    const double azimuth = fmod(angles.azimuth + 540, 360) - 180;  // Unwrapped from the window offset
+    if (fabs(azimuth) > maxAngle || angles.altitude < minAltitude || angles.altitude > maxAngle) {
+        return false;
+    }
+
+    const TruePosition position(viewer[0] + viewer[2] * tan(radians(azimuth)),
+                                viewer[1] - viewer[2] * tan(radians(angles.altitude)));
+    if (!reachable(position)) {
+        return false;
+    }
+    blocker = position;
+    return true;
+}
+
+void setTolerance(double inches) {
+    tolerance = max(inches, 0.0);
+    catchUp();
+}
+
+double getTolerance() {
+    return tolerance;
+}
+
+bool plan(Time now, double limit, TruePosition& blocker, Time& next, bool& missed) {
+    missed = false;
+    if (!project(now, blocker)) {
+        next = now + Time::fromMinutes(maxInterval);
+        return false;
+    }
+    if (limit <= 0) {
+        next = now + Time::fromMinutes(pace(now, blocker));
+        return true;
+    }
+
+    // Only the wait after this move decides whether the shadow stays within
+    // limit; how far ahead the blocker leads doesn't.
+    Time lead {0};
+    reach(now, blocker, limit, lead);
+    TruePosition ahead {0, 0};
+    if (project(lead, ahead)) {
+        blocker = ahead;
+    }
+    missed = !reach(lead, blocker, limit, next);
+    return true;
+}
+
+Parser::Command track(Time now) {
+    TruePosition blocker {0, 0};
+    Time next {0};
+    bool missed = false;
+    const bool moving = plan(now, tolerance, blocker, next, missed);
+    Scheduler::setNext(task, next);
+    if (!moving) {
+        return Parser::empty;
+    }
+
+    target = blocker;
+    moves++;
+    if (missed) {
+        misses++;
+    }
+
+    const Position position(blocker, MotorSystem::originOffset);
+    return Parser::Command(Parser::CommandType::Go, "", position.x, position.y);
+}
+
+void printStatus() {
+    Serial.print("Viewer: ");
+    Serial.print(viewer[0]);
+    Serial.print(", ");
+    Serial.print(viewer[1]);
+    Serial.print(", ");
+    Serial.println(viewer[2]);
+    Serial.print("Sun path fit error (degrees): ");
+    Serial.println(model.fitError(), 4);
+    Serial.print("Drift tolerance (in, 0 for paced): ");
+    Serial.println(tolerance);
+    Serial.print("Drift misses (shadow beyond tolerance): ");
+    Serial.println(misses);
+    Serial.print("Tracking moves / last target: ");
+    Serial.print(moves);
+    Serial.print(" / ");
+    printTo(Serial, target);
+    Serial.println();
+}
+}
@@ -0,0 +1,80 @@
+#ifndef Tracker_h
+#define Tracker_h
+
+#include <Arduino.h>
+#include "Lengths.h"
+#include "Parser.h"
+#include "Time.h"
+
+// Keeps the blocker between the sun and the viewer's eyes, with no host:
+// a Scheduler task works out the sun's angles to the window, projects them
+// through the viewer onto the window's plane and goes there.
+namespace Tracker {
+
+/**
+ * @brief Schedule the tracking task. Like every task, it only moves
+ * anything after `start`.
+ *
+ */
+void init();
+
+/**
+ * @brief Plan the next move straight away rather than at the end of the
+ * current interval, e.g. on `start` or after a setting changes.
+ *
+ */
+void catchUp();
+
+/**
+ * @brief Set whose eyes to shade from text of the form "x y z": x and y as
+ * for the strings, z in inches from the window into the room.
+ *
+ * @return false if the text doesn't hold three numbers with z positive
+ */
+bool setViewer(const char* text);
+
+/**
+ * @brief Where the blocker has to be at the time, as in find_position()
+ * in py/window.py.
+ *
+ * @return false if the sun is behind the window or too low, or its shadow
+ * would fall outside the area the strings can reach
+ */
+bool project(Time time, Lengths::TruePosition& blocker);
+
+/**
+ * @brief Move only when the shadow drifts tolerance inches from the blocker;
+ * 0 goes back to moving at a pace set by the shadow's speed.
+ *
+ */
+void setTolerance(double inches);
+
+double getTolerance();
+
+/**
+ * @brief Where to put the blocker now, and when to move it next, for a
+ * drift tolerance of limit inches. Only reads the tracker's state, so
+ * it can be tried with any limit without disturbing the tracking task.
+ *
+ * With a limit, the blocker goes where the shadow will be once it has
+ * drifted limit from where it is now, leading it, and the next move is
+ * when the shadow will have drifted limit past that, so it's never more
+ * than limit off in between, unless the shadow drifts limit in under 15
+ * seconds; then missed is set. Otherwise the blocker goes to the shadow,
+ * and the next move is when it will have moved about stride.
+ *
+ * @return false at night, or whenever there's nothing to shade
+ */
+bool plan(Time now, double limit, Lengths::TruePosition& blocker, Time& next, bool& missed);
+
+/**
+ * @brief The tracking task: a go to the blocker's position, or nothing at
+ * night, rescheduling itself as plan() says.
+ *
+ */
+Parser::Command track(Time now);
+
+void printStatus();
+}
+
+#endif
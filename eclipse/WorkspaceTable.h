@@ -0,0 +1,99 @@
+// Generated by py/workspace_table.py for the MiniEclipse rig in Rig.h; do not edit.
+#ifndef WorkspaceTable_h
+#define WorkspaceTable_h
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+namespace WorkspaceTable {
+// The rig the table was made for, checked against the one being built
+constexpr double rigWidth {41.232};
+constexpr double rigRadius {0.3781171306988631};
+
+constexpr double spacing {1.5};  // inches between nodes
+constexpr double xStart {0};
+constexpr double yStart {6.0};
+constexpr int columns {29};
+constexpr int rows {34};
+constexpr double unitsPerInch {512};
+
+// Worst interpolation error over the table: 0.04583 in
+constexpr double maxError {0.04583};
+
+// Total lengths (left, right) at each node, row by row from the top
+const uint16_t lengths[rows * columns][2] PROGMEM {
+    {3078, 21610}, {3220, 20849}, {3530, 20089}, {3969, 19330}, {4501, 18571}, {5095, 17813}, {5732, 17056}, {6398, 16300}, {7086, 15545}, {7790, 14791}, {8504, 14040}, {9228, 13290}, {9958, 12542}, {10694, 11797}, {11434, 11055}, {12178, 10317}, {12924, 9584}, {13673, 8856}, {14424, 8137}, {15177, 7428}, {15931, 6732}, {16687, 6054}, {17443, 5401}, {18201, 4784}, {18959, 4219}, {19719, 3731}, {20478, 3352}, {21239, 3124}, {22000, 3078},
+    {3845, 21727}, {3959, 20971}, {4214, 20215}, {4587, 19461}, {5052, 18707}, {5586, 17955}, {6171, 17205}, {6793, 16455}, {7444, 15708}, {8115, 14963}, {8803, 14220}, {9503, 13481}, {10214, 12744}, {10932, 12012}, {11656, 11285}, {12386, 10563}, {13121, 9849}, {13859, 9143}, {14600, 8449}, {15344, 7769}, {16091, 7108}, {16839, 6471}, {17589, 5866}, {18340, 5305}, {19093, 4804}, {19847, 4383}, {20602, 4067}, {21358, 3882}, {22115, 3845},
+    {4612, 21871}, {4708, 21120}, {4923, 20370}, {5245, 19622}, {5655, 18875}, {6136, 18130}, {6672, 17387}, {7250, 16646}, {7862, 15908}, {8500, 15172}, {9158, 14441}, {9832, 13713}, {10520, 12990}, {11218, 12273}, {11925, 11562}, {12639, 10859}, {13360, 10166}, {14085, 9485}, {14815, 8819}, {15548, 8170}, {16285, 7545}, {17025, 6949}, {17767, 6391}, {18511, 5882}, {19257, 5436}, {20005, 5068}, {20754, 4799}, {21504, 4643}, {22256, 4612},
+    {5379, 22041}, {5462, 21296}, {5648, 20553}, {5931, 19811}, {6295, 19072}, {6730, 18335}, {7220, 17601}, {7757, 16869}, {8331, 16142}, {8935, 15418}, {9562, 14698}, {10210, 13984}, {10873, 13277}, {11550, 12576}, {12237, 11884}, {12934, 11202}, {13638, 10532}, {14349, 9876}, {15066, 9238}, {15788, 8622}, {16514, 8033}, {17243, 7477}, {17976, 6963}, {18712, 6499}, {19450, 6099}, {20191, 5775}, {20933, 5540}, {21677, 5406}, {22423, 5380},
+    {6147, 22237}, {6219, 21499}, {6383, 20762}, {6634, 20029}, {6962, 19298}, {7356, 18570}, {7807, 17846}, {8305, 17125}, {8843, 16409}, {9413, 15697}, {10011, 14992}, {10630, 14293}, {11268, 13601}, {11922, 12918}, {12589, 12246}, {13267, 11585}, {13954, 10939}, {14650, 10310}, {15352, 9702}, {16061, 9118}, {16775, 8563}, {17493, 8045}, {18216, 7570}, {18942, 7146}, {19672, 6785}, {20404, 6496}, {21139, 6288}, {21876, 6170}, {22616, 6147},
+    {6915, 22457}, {6979, 21727}, {7126, 20999}, {7351, 20274}, {7647, 19552}, {8008, 18834}, {8423, 18120}, {8887, 17411}, {9391, 16707}, {9929, 16009}, {10496, 15318}, {11088, 14635}, {11701, 13961}, {12332, 13297}, {12977, 12645}, {13635, 12007}, {14305, 11385}, {14984, 10782}, {15671, 10203}, {16366, 9649}, {17067, 9128}, {17774, 8644}, {18485, 8204}, {19201, 7816}, {19921, 7487}, {20644, 7226}, {21371, 7040}, {22100, 6935}, {22832, 6915},
+    {7682, 22702}, {7740, 21979}, {7873, 21260}, {8077, 20544}, {8348, 19833}, {8678, 19125}, {9063, 18423}, {9495, 17726}, {9968, 17036}, {10476, 16352}, {11015, 15676}, {11580, 15010}, {12168, 14353}, {12775, 13708}, {13399, 13077}, {14037, 12462}, {14688, 11864}, {15350, 11288}, {16021, 10736}, {16701, 10212}, {17388, 9721}, {18082, 9268}, {18782, 8860}, {19487, 8502}, {20197, 8201}, {20910, 7964}, {21628, 7796}, {22349, 7701}, {23073, 7683},
+    {8450, 22970}, {8503, 22256}, {8624, 21546}, {8810, 20840}, {9059, 20139}, {9364, 19443}, {9722, 18753}, {10125, 18069}, {10569, 17392}, {11050, 16723}, {11562, 16063}, {12101, 15414}, {12664, 14775}, {13248, 14150}, {13850, 13540}, {14469, 12947}, {15101, 12373}, {15745, 11822}, {16400, 11296}, {17065, 10800}, {17738, 10337}, {18418, 9913}, {19106, 9533}, {19799, 9201}, {20498, 8924}, {21201, 8707}, {21909, 8553}, {22621, 8467}, {23336, 8450},
+    {9218, 23260}, {9266, 22556}, {9377, 21856}, {9549, 21160}, {9779, 20470}, {10062, 19786}, {10395, 19108}, {10773, 18438}, {11192, 17775}, {11646, 17121}, {12133, 16477}, {12647, 15845}, {13187, 15225}, {13748, 14619}, {14329, 14030}, {14928, 13458}, {15541, 12908}, {16167, 12380}, {16806, 11880}, {17455, 11409}, {18113, 10973}, {18780, 10575}, {19454, 10219}, {20136, 9911}, {20823, 9654}, {21516, 9454}, {22213, 9312}, {22916, 9234}, {23622, 9218},
+    {9986, 23572}, {10030, 22877}, {10133, 22188}, {10292, 21503}, {10506, 20825}, {10770, 20153}, {11082, 19488}, {11437, 18831}, {11831, 18182}, {12262, 17544}, {12725, 16917}, {13216, 16301}, {13733, 15700}, {14273, 15113}, {14833, 14544}, {15411, 13994}, {16006, 13465}, {16615, 12961}, {17236, 12484}, {17870, 12037}, {18513, 11625}, {19166, 11250}, {19827, 10916}, {20496, 10628}, {21171, 10390}, {21853, 10204}, {22540, 10073}, {23232, 10000}, {23929, 9986},
+    {10754, 23905}, {10795, 23220}, {10890, 22541}, {11039, 21868}, {11238, 21201}, {11485, 20541}, {11778, 19890}, {12112, 19247}, {12486, 18613}, {12894, 17990}, {13335, 17379}, {13804, 16781}, {14300, 16197}, {14819, 15629}, {15359, 15080}, {15918, 14550}, {16494, 14043}, {17085, 13560}, {17690, 13105}, {18308, 12681}, {18936, 12290}, {19575, 11936}, {20222, 11623}, {20878, 11353}, {21542, 11130}, {22212, 10956}, {22888, 10835}, {23570, 10767}, {24257, 10754},
+    {11522, 24258}, {11560, 23583}, {11649, 22915}, {11788, 22253}, {11975, 21598}, {12207, 20951}, {12483, 20313}, {12799, 19684}, {13152, 19065}, {13541, 18457}, {13961, 17862}, {14409, 17281}, {14885, 16715}, {15384, 16166}, {15905, 15635}, {16445, 15125}, {17003, 14638}, {17577, 14176}, {18165, 13742}, {18767, 13338}, {19380, 12967}, {20005, 12632}, {20639, 12336}, {21282, 12082}, {21933, 11873}, {22591, 11711}, {23256, 11597}, {23928, 11534}, {24605, 11522},
+    {12290, 24629}, {12326, 23966}, {12409, 23308}, {12540, 22658}, {12715, 22016}, {12934, 21381}, {13194, 20756}, {13494, 20141}, {13830, 19537}, {14199, 18945}, {14600, 18366}, {15030, 17801}, {15486, 17252}, {15966, 16721}, {16468, 16208}, {16990, 15717}, {17531, 15249}, {18088, 14806}, {18660, 14391}, {19246, 14006}, {19845, 13653}, {20455, 13336}, {21075, 13056}, {21705, 12817}, {22344, 12620}, {22990, 12467}, {23644, 12360}, {24305, 12301}, {24972, 12290},
+    {13057, 25019}, {13091, 24366}, {13170, 23720}, {13293, 23082}, {13459, 22451}, {13666, 21830}, {13912, 21218}, {14196, 20617}, {14516, 20027}, {14868, 19450}, {15252, 18887}, {15663, 18338}, {16101, 17806}, {16563, 17292}, {17048, 16797}, {17553, 16324}, {18076, 15874}, {18617, 15449}, {19173, 15052}, {19744, 14684}, {20328, 14348}, {20923, 14046}, {21530, 13781}, {22147, 13555}, {22773, 13369}, {23408, 13225}, {24050, 13124}, {24700, 13068}, {25356, 13058},
+    {13825, 25427}, {13857, 24785}, {13932, 24150}, {14048, 23523}, {14205, 22905}, {14401, 22296}, {14635, 21698}, {14906, 21110}, {15210, 20535}, {15547, 19972}, {15913, 19424}, {16308, 18892}, {16729, 18376}, {17175, 17878}, {17642, 17400}, {18130, 16944}, {18638, 16511}, {19162, 16103}, {19703, 15722}, {20259, 15370}, {20828, 15050}, {21410, 14763}, {22003, 14511}, {22607, 14296}, {23220, 14120}, {23843, 13983}, {24474, 13888}, {25113, 13836}, {25758, 13825},
+    {14593, 25851}, {14624, 25219}, {14694, 24596}, {14804, 23981}, {14953, 23375}, {15140, 22779}, {15363, 22194}, {15620, 21620}, {15911, 21058}, {16233, 20510}, {16585, 19977}, {16964, 19460}, {17369, 18959}, {17798, 18477}, {18249, 18016}, {18722, 17575}, {19213, 17158}, {19722, 16766}, {20248, 16401}, {20789, 16064}, {21344, 15758}, {21912, 15484}, {22492, 15244}, {23083, 15040}, {23684, 14872}, {24295, 14743}, {24914, 14653}, {25542, 14603}, {26177, 14593},
+    {15361, 26290}, {15390, 25670}, {15457, 25058}, {15562, 24454}, {15704, 23861}, {15881, 23277}, {16094, 22705}, {16340, 22144}, {16618, 21596}, {16927, 21063}, {17264, 20544}, {17628, 20041}, {18018, 19556}, {18432, 19089}, {18869, 18642}, {19326, 18217}, {19802, 17816}, {20296, 17438}, {20808, 17088}, {21334, 16765}, {21875, 16472}, {22430, 16210}, {22996, 15981}, {23575, 15786}, {24163, 15626}, {24762, 15504}, {25370, 15418}, {25987, 15371}, {26611, 15361},
+    {16129, 26745}, {16157, 26135}, {16221, 25534}, {16320, 24943}, {16456, 24361}, {16625, 23790}, {16828, 23230}, {17064, 22683}, {17330, 22148}, {17626, 21628}, {17950, 21123}, {18301, 20635}, {18677, 20164}, {19077, 19712}, {19498, 19280}, {19941, 18869}, {20403, 18481}, {20883, 18118}, {21380, 17781}, {21893, 17471}, {22420, 17190}, {22961, 16939}, {23515, 16720}, {24081, 16534}, {24658, 16382}, {25245, 16265}, {25841, 16183}, {26446, 16138}, {27060, 16129},
+    {16897, 27214}, {16923, 26615}, {16984, 26025}, {17080, 25445}, {17209, 24875}, {17371, 24316}, {17566, 23769}, {17791, 23234}, {18047, 22713}, {18331, 22206}, {18643, 21715}, {18981, 21240}, {19344, 20783}, {19730, 20344}, {20138, 19926}, {20566, 19529}, {21014, 19155}, {21481, 18805}, {21964, 18480}, {22464, 18182}, {22978, 17912}, {23506, 17672}, {24047, 17462}, {24601, 17284}, {25165, 17139}, {25741, 17027}, {26326, 16949}, {26920, 16906}, {27524, 16897},
+    {17665, 27696}, {17690, 27108}, {17749, 26529}, {17840, 25960}, {17964, 25402}, {18119, 24855}, {18306, 24320}, {18522, 23798}, {18768, 23289}, {19041, 22795}, {19342, 22317}, {19668, 21855}, {20018, 21411}, {20391, 20986}, {20786, 20581}, {21201, 20197}, {21636, 19835}, {22089, 19498}, {22560, 19185}, {23046, 18898}, {23548, 18638}, {24063, 18408}, {24592, 18206}, {25133, 18035}, {25686, 17896}, {26250, 17789}, {26824, 17714}, {27408, 17673}, {28000, 17665},
+    {18433, 28191}, {18457, 27613}, {18513, 27046}, {18601, 26488}, {18719, 25941}, {18869, 25406}, {19048, 24882}, {19256, 24372}, {19492, 23876}, {19756, 23395}, {20045, 22929}, {20360, 22480}, {20698, 22049}, {21059, 21636}, {21442, 21243}, {21845, 20872}, {22267, 20522}, {22708, 20196}, {23165, 19894}, {23639, 19618}, {24128, 19368}, {24632, 19146}, {25149, 18952}, {25678, 18788}, {26220, 18655}, {26772, 18552}, {27335, 18480}, {27908, 18441}, {28490, 18433},
+    {19201, 28698}, {19224, 28131}, {19278, 27574}, {19362, 27027}, {19476, 26491}, {19619, 25967}, {19792, 25456}, {19992, 24958}, {20220, 24473}, {20474, 24004}, {20754, 23550}, {21058, 23113}, {21385, 22694}, {21734, 22294}, {22105, 21913}, {22496, 21553}, {22907, 21214}, {23335, 20899}, {23780, 20607}, {24242, 20341}, {24719, 20100}, {25211, 19886}, {25716, 19700}, {26234, 19542}, {26764, 19414}, {27306, 19315}, {27858, 19246}, {28420, 19208}, {28992, 19201},
+    {19969, 29216}, {19991, 28660}, {20043, 28113}, {20124, 27577}, {20233, 27052}, {20372, 26540}, {20538, 26039}, {20731, 25552}, {20951, 25080}, {21196, 24622}, {21466, 24180}, {21760, 23755}, {22077, 23347}, {22416, 22958}, {22775, 22588}, {23155, 22239}, {23554, 21912}, {23970, 21606}, {24404, 21325}, {24854, 21067}, {25320, 20835}, {25800, 20629}, {26294, 20449}, {26801, 20297}, {27320, 20174}, {27850, 20079}, {28392, 20013}, {28944, 19976}, {29505, 19969},
+    {20737, 29746}, {20758, 29199}, {20808, 28663}, {20886, 28138}, {20992, 27623}, {21125, 27121}, {21285, 26632}, {21472, 26156}, {21684, 25695}, {21921, 25248}, {22182, 24818}, {22467, 24404}, {22774, 24007}, {23102, 23629}, {23451, 23270}, {23820, 22931}, {24208, 22614}, {24613, 22318}, {25036, 22045}, {25475, 21796}, {25929, 21572}, {26398, 21373}, {26881, 21200}, {27377, 21053}, {27885, 20934}, {28405, 20843}, {28936, 20779}, {29478, 20744}, {30029, 20737},
+    {21505, 30285}, {21525, 29749}, {21573, 29223}, {21649, 28708}, {21751, 28204}, {21879, 27713}, {22034, 27234}, {22214, 26769}, {22419, 26318}, {22649, 25882}, {22902, 25462}, {23177, 25059}, {23475, 24673}, {23794, 24305}, {24133, 23957}, {24491, 23628}, {24869, 23320}, {25264, 23033}, {25675, 22769}, {26104, 22528}, {26547, 22311}, {27005, 22119}, {27477, 21951}, {27963, 21810}, {28460, 21695}, {28970, 21607}, {29491, 21545}, {30022, 21512}, {30564, 21505},
+    {22273, 30835}, {22293, 30308}, {22339, 29792}, {22412, 29287}, {22510, 28793}, {22634, 28312}, {22784, 27844}, {22958, 27389}, {23157, 26949}, {23379, 26524}, {23624, 26114}, {23891, 25721}, {24180, 25345}, {24490, 24987}, {24819, 24648}, {25168, 24329}, {25535, 24030}, {25920, 23752}, {26322, 23496}, {26739, 23262}, {27173, 23052}, {27620, 22866}, {28082, 22704}, {28557, 22568}, {29044, 22457}, {29544, 22371}, {30055, 22312}, {30576, 22279}, {31108, 22273},
+    {23041, 31393}, {23060, 30876}, {23105, 30370}, {23175, 29874}, {23270, 29391}, {23391, 28920}, {23535, 28461}, {23704, 28017}, {23896, 27587}, {24112, 27171}, {24349, 26772}, {24609, 26388}, {24889, 26022}, {25190, 25674}, {25511, 25344}, {25850, 25034}, {26208, 24743}, {26583, 24473}, {26974, 24225}, {27382, 23999}, {27805, 23795}, {28243, 23615}, {28694, 23458}, {29159, 23326}, {29637, 23218}, {30126, 23136}, {30628, 23079}, {31140, 23047}, {31662, 23041},
+    {23809, 31961}, {23827, 31453}, {23871, 30956}, {23939, 30470}, {24031, 29996}, {24147, 29535}, {24288, 29086}, {24451, 28651}, {24638, 28231}, {24847, 27825}, {25077, 27435}, {25329, 27061}, {25602, 26704}, {25894, 26365}, {26206, 26044}, {26537, 25742}, {26885, 25460}, {27251, 25198}, {27633, 24956}, {28031, 24737}, {28444, 24539}, {28872, 24365}, {29314, 24213}, {29769, 24085}, {30237, 23981}, {30717, 23901}, {31209, 23845}, {31711, 23815}, {32225, 23809},
+    {24577, 32536}, {24595, 32038}, {24637, 31550}, {24703, 31073}, {24792, 30609}, {24905, 30157}, {25041, 29718}, {25200, 29292}, {25381, 28881}, {25583, 28485}, {25807, 28104}, {26052, 27739}, {26317, 27391}, {26602, 27060}, {26906, 26748}, {27228, 26454}, {27567, 26179}, {27924, 25924}, {28297, 25690}, {28686, 25477}, {29090, 25285}, {29509, 25116}, {29941, 24968}, {30387, 24844}, {30845, 24743}, {31316, 24666}, {31798, 24612}, {32292, 24583}, {32796, 24577},
+    {25345, 33120}, {25362, 32630}, {25403, 32151}, {25467, 31684}, {25554, 31228}, {25663, 30786}, {25795, 30356}, {25949, 29939}, {26125, 29537}, {26322, 29150}, {26540, 28778}, {26778, 28422}, {27036, 28082}, {27313, 27760}, {27609, 27455}, {27923, 27169}, {28254, 26901}, {28602, 26653}, {28966, 26426}, {29346, 26218}, {29741, 26032}, {30151, 25867}, {30574, 25725}, {31011, 25604}, {31460, 25506}, {31922, 25431}, {32395, 25379}, {32879, 25350}, {33374, 25345},
+    {26113, 33710}, {26130, 33230}, {26169, 32760}, {26231, 32301}, {26315, 31855}, {26422, 31421}, {26550, 30999}, {26700, 30592}, {26871, 30199}, {27062, 29820}, {27274, 29456}, {27506, 29108}, {27757, 28777}, {28027, 28462}, {28315, 28165}, {28621, 27886}, {28945, 27626}, {29285, 27385}, {29640, 27163}, {30012, 26961}, {30398, 26780}, {30799, 26620}, {31213, 26482}, {31641, 26365}, {32082, 26270}, {32534, 26197}, {32999, 26146}, {33474, 26118}, {33961, 26113},
+    {26881, 34308}, {26897, 33836}, {26936, 33375}, {26996, 32925}, {27078, 32487}, {27181, 32061}, {27306, 31649}, {27451, 31250}, {27617, 30865}, {27804, 30494}, {28010, 30139}, {28236, 29799}, {28481, 29476}, {28744, 29169}, {29025, 28879}, {29324, 28607}, {29639, 28353}, {29971, 28118}, {30319, 27902}, {30682, 27706}, {31060, 27530}, {31452, 27374}, {31858, 27239}, {32278, 27125}, {32709, 27033}, {33154, 26962}, {33609, 26913}, {34076, 26886}, {34554, 26881},
+    {27649, 34913}, {27665, 34449}, {27702, 33996}, {27761, 33554}, {27840, 33125}, {27941, 32708}, {28062, 32303}, {28204, 31913}, {28365, 31536}, {28547, 31173}, {28748, 30826}, {28968, 30494}, {29206, 30177}, {29463, 29878}, {29738, 29595}, {30029, 29330}, {30337, 29082}, {30662, 28853}, {31002, 28643}, {31357, 28452}, {31727, 28280}, {32111, 28129}, {32509, 27997}, {32920, 27887}, {33343, 27797}, {33779, 27728}, {34226, 27680}, {34685, 27654}, {35155, 27649},
+    {28417, 35524}, {28432, 35068}, {28469, 34623}, {28526, 34190}, {28603, 33768}, {28701, 33359}, {28819, 32963}, {28957, 32580}, {29114, 32211}, {29291, 31856}, {29487, 31516}, {29702, 31191}, {29934, 30882}, {30185, 30590}, {30453, 30314}, {30738, 30055}, {31039, 29813}, {31356, 29590}, {31688, 29385}, {32036, 29198}, {32398, 29031}, {32774, 28884}, {33164, 28756}, {33567, 28648}, {33982, 28561}, {34410, 28494}, {34849, 28447}, {35300, 28422}, {35761, 28417},
+};
+
+// Worst interpolation error inside each cell, in the same units
+const uint8_t cellErrors[(rows - 1) * (columns - 1)] PROGMEM {
+    23, 21, 19, 17, 16, 14, 12, 11, 10, 10, 9, 8, 8, 7, 8, 8, 9, 9, 10, 11, 12, 13, 15, 16, 18, 20, 22, 24,
+    19, 18, 16, 15, 14, 13, 12, 11, 10, 9, 8, 8, 8, 7, 7, 8, 8, 9, 10, 10, 11, 12, 13, 15, 16, 17, 18, 20,
+    16, 15, 14, 13, 13, 12, 11, 10, 10, 9, 8, 8, 7, 7, 7, 7, 8, 8, 9, 10, 10, 11, 12, 13, 14, 15, 16, 16,
+    14, 13, 13, 12, 12, 11, 10, 9, 9, 8, 8, 7, 7, 7, 7, 7, 8, 8, 9, 9, 10, 11, 11, 12, 13, 13, 14, 14,
+    12, 12, 11, 11, 11, 10, 9, 9, 8, 8, 7, 7, 7, 7, 7, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 12,
+    11, 11, 11, 10, 10, 9, 9, 9, 8, 8, 7, 7, 7, 7, 7, 7, 7, 8, 8, 8, 9, 9, 10, 10, 10, 11, 11, 11,
+    10, 10, 10, 9, 9, 8, 8, 8, 8, 7, 7, 7, 6, 6, 6, 7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 10, 10, 10,
+    9, 9, 9, 9, 8, 8, 8, 7, 7, 7, 7, 6, 6, 6, 6, 6, 7, 7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 9,
+    8, 8, 8, 8, 8, 8, 7, 7, 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 7, 7, 8, 8, 8, 8, 8, 8, 8, 9,
+    8, 8, 8, 8, 7, 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 8, 8, 8, 8,
+    7, 7, 7, 7, 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 5, 5, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 6, 6, 6, 6, 6, 6, 6, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7,
+    7, 7, 6, 6, 6, 6, 6, 6, 6, 6, 6, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7, 6, 6, 7,
+    6, 6, 6, 6, 6, 6, 5, 6, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 6, 6, 6, 5, 6, 6,
+    6, 6, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 4, 4, 5, 5, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 4, 4, 4, 5, 5, 5, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 4, 4, 4, 4, 5, 5, 4, 4, 4, 4, 5, 4, 4, 4, 5, 4, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 4, 5, 5, 4, 4, 5, 4, 4, 5,
+    4, 4, 5, 5, 4, 5, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 4, 4, 5,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 3, 3, 4, 4, 4, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 3, 4, 4, 4, 4, 3, 3, 3, 3, 3, 4, 3, 4, 3, 3, 3, 4, 4, 4, 4, 4, 3, 4, 4,
+    4, 4, 4, 4, 4, 3, 4, 4, 3, 3, 3, 3, 3, 3, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4,
+    4, 3, 4, 4, 3, 3, 3, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 3, 3, 3,
+    4, 3, 4, 3, 3, 3, 3, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 3, 3, 3,
+    3, 3, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+};
+}
+
+#endif
@@ -1,17 +1,18 @@
 
 #include "Executor.h"
 #include "Parser.h"
+#include "LineReader.h"
+#include "Binary.h"
 #include "Lengths.h"
+#include "Rig.h"
 // Mini-Eclipse project (January 2023)
 // Martin Chan (philadelphia@mit.edu)
 
 static constexpr bool verbose = true;
 
-static constexpr int enableMotorPin {8};
+static constexpr int enableMotorPin {Rig::Active::enablePin};
 const auto initialStrings = Lengths::Tangential(double(8), double(42));
 
-String string;
-
 void setup() {
   pinMode(enableMotorPin, OUTPUT);
   Serial.begin(9600);
@@ -22,11 +23,21 @@ void setup() {
 
 void loop() {
   // Just for unscheduled commands
-  if (Serial.available()) {
-    string = Serial.readStringUntil('\n');
-
-    auto command = Parser::parse(string);
-    Executor::execute(command);
+  if (Binary::enabled()) {
+    auto command = Parser::empty;
+    if (Binary::poll(command)) {
+      Executor::execute(command);
+    }
+  } else {
+    char* line = LineReader::poll();
+    if (line) {
+      if (!Executor::streaming()) {
+        Serial.print("> ");
+        Serial.println(line);
+      }
+
+      Executor::executeLine(line);
+    }
   }
   Executor::run();
 }
@@ -0,0 +1,222 @@
+"""
+Host side of the binary command frames in eclipse/Binary.h: COBS-framed,
+CRC-16 checked, fixed-layout payloads. Send `binary 1` as text first (or
+switch_to_binary()), then write encode(...) frames to the serial port.
+
+    frame = encode("gostep", 1234, 5678)
+    port.write(frame)
+
+To stream a long run of moves at full speed, use CreditStreamer.
+"""
+import struct
+
+# Must match Parser::CommandType, whose values are the frame types.
+COMMAND_TYPES = {
+    "invalid": 0,
+    "test": 1,
+    "stop": 2,
+    "start": 3,
+    "pause": 4,
+    "settime": 5,
+    "getstep": 6,
+    "gostep": 7,
+    "step": 8,
+    "getinch": 9,
+    "goinch": 10,
+    "inch": 11,
+    "getpos": 12,
+    "go": 13,
+    "vel": 14,
+    "origin": 15,
+    "fix": 16,
+    "status": 17,
+    "binary": 18,
+    "stream": 19,
+    "ok": 20,  # Replies from here on
+    "no": 21,
+    "credit": 22,
+    "record": 23,  # Commands again
+    "end": 24,
+    "play": 25,
+    "viewer": 26,
+    "drift": 27,
+}
+COMMAND_NAMES = {value: name for name, value in COMMAND_TYPES.items()}
+
+# Payload layouts, as struct formats; None for settime's text.
+LAYOUTS = {
+    "gostep": "<ii",
+    "step": "<ii",
+    "goinch": "<ff",
+    "inch": "<ff",
+    "go": "<ff",
+    "vel": "<ff",
+    "origin": "<ff",
+    "fix": "<ff",
+    "drift": "<ff",
+    "test": "<B",
+    "binary": "<B",
+    "stream": "<B",
+    "ok": "<B",
+    "no": "<B",
+    "credit": "<B",
+    "play": "<B",
+    "settime": None,
+    "viewer": None,
+}
+
+MAX_TEXT = 23  # Parser::dataSize - 1
+
+
+def crc16(data: bytes) -> int:
+    """
+    CRC-16/CCITT-FALSE, as _crc_xmodem_update() from 0xFFFF on the device.
+    """
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data: bytes) -> bytes:
+    out = bytearray([0])
+    code_index = 0
+    run = 1
+    for byte in data:
+        if byte == 0:
+            out[code_index] = run
+            code_index = len(out)
+            out.append(0)
+            run = 1
+        else:
+            out.append(byte)
+            run += 1
+            if run == 0xFF:
+                out[code_index] = run
+                code_index = len(out)
+                out.append(0)
+                run = 1
+    out[code_index] = run
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> bytes:
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("Malformed COBS frame")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode(command: str, first=0, second=0, text: str = "") -> bytes:
+    """
+    returns one whole frame, delimiter included, ready to write to the port.
+    """
+    layout = LAYOUTS.get(command, "")
+    raw = bytes([COMMAND_TYPES[command]])
+    if layout is None:
+        data = text.encode("ascii")
+        if len(data) > MAX_TEXT:
+            raise ValueError(f"Text longer than {MAX_TEXT} bytes")
+        raw += data
+    elif layout == "<ii":
+        raw += struct.pack(layout, round(first), round(second))
+    elif layout == "<ff":
+        raw += struct.pack(layout, first, second)
+    elif layout == "<B":
+        raw += struct.pack(layout, int(first))
+    raw += struct.pack("<H", crc16(raw))
+    return cobs_encode(raw) + b"\x00"
+
+
+def decode(frame: bytes):
+    """
+    Inverse of encode(), delimiter optional; returns (command, values), where
+    values is the payload tuple or the text. Raises ValueError on a bad frame.
+    """
+    raw = cobs_decode(frame.rstrip(b"\x00"))
+    if len(raw) < 3:
+        raise ValueError("Frame too short")
+    body, (check,) = raw[:-2], struct.unpack("<H", raw[-2:])
+    if crc16(body) != check:
+        raise ValueError("CRC mismatch")
+
+    command = COMMAND_NAMES.get(body[0], "invalid")
+    layout = LAYOUTS.get(command, "")
+    payload = body[1:]
+    if layout is None:
+        return command, payload.decode("ascii")
+    if layout == "":
+        if payload:
+            raise ValueError("Unexpected payload")
+        return command, ()
+    return command, struct.unpack(layout, payload)
+
+
+def switch_to_binary() -> bytes:
+    """
+    The text line that switches the device over to frames.
+    """
+    return b"binary 1\n"
+
+
+def switch_to_text() -> bytes:
+    return encode("binary", 0)
+
+
+class CreditStreamer:
+    """
+    Keeps the device's move queue full without overrunning it, over the
+    binary link. port needs write() and read_until(), as pyserial's does.
+
+    With `stream 1` on, the device answers each command with "ok" or "no"
+    and the queue's free slots at that moment, and sends "credit" whenever a
+    queued move starts or a scheduled or played command takes a slot. Replies come in order, so the slots still free are
+    the last reported credit less the commands not yet answered.
+    """
+
+    def __init__(self, port) -> None:
+        self.port = port
+        self.credit = 0
+        self.unanswered = 0
+        self.rejected = 0
+
+    def start(self):
+        self.port.write(encode("stream", 1))
+        self.unanswered += 1
+        while self.unanswered:
+            self.read_reply()
+
+    def read_reply(self):
+        command, (credit,) = decode(self.port.read_until(b"\x00"))
+        self.credit = credit
+        if command in ("ok", "no"):
+            self.unanswered -= 1
+        if command == "no":
+            self.rejected += 1
+        return command
+
+    def available(self):
+        return self.credit - self.unanswered
+
+    def send(self, frame: bytes):
+        """
+        Waits for room, then sends one move frame.
+        """
+        while self.available() <= 0:
+            self.read_reply()
+        self.port.write(frame)
+        self.unanswered += 1
+
+    def finish(self):
+        while self.unanswered:
+            self.read_reply()
@@ -0,0 +1,97 @@
+import unittest
+
+import binary_link as b
+
+
+class TestBinaryLink(unittest.TestCase):
+    def test_crc_check_value(self):
+        # The standard check value for CRC-16/CCITT-FALSE
+        self.assertEqual(b.crc16(b"123456789"), 0x29B1)
+
+    def test_cobs_round_trip(self):
+        for data in (b"", b"\x00", b"\x00\x00", b"\x11\x00\x22", bytes(range(1, 255)), bytes(300)):
+            encoded = b.cobs_encode(data)
+            self.assertNotIn(0, encoded)
+            self.assertEqual(b.cobs_decode(encoded), data)
+
+    def test_loopback(self):
+        cases = [
+            ("gostep", (1234, -5678)),
+            ("step", (0, 0)),
+            ("go", (12.5, 30.25)),
+            ("vel", (-0.5, 0.125)),
+            ("test", (3,)),
+            ("binary", (0,)),
+            ("status", ()),
+            ("stop", ()),
+            ("record", ()),
+            ("play", (0,)),
+        ]
+        for command, values in cases:
+            frame = b.encode(command, *values)
+            self.assertEqual(frame[-1], 0)
+            self.assertNotIn(0, frame[:-1])
+            self.assertEqual(b.decode(frame), (command, values))
+
+        frame = b.encode("settime", text="2023.02.06 19:52 -5")
+        self.assertEqual(b.decode(frame), ("settime", "2023.02.06 19:52 -5"))
+
+    def test_corruption_is_caught(self):
+        frame = bytearray(b.encode("gostep", 1234, 5678))
+        frame[3] ^= 0x01
+        with self.assertRaises(ValueError):
+            b.decode(bytes(frame))
+
+    def test_smaller_than_text(self):
+        self.assertLess(len(b.encode("gostep", 12345, 23456)), len(b"gostep 12345 23456\n"))
+        self.assertLess(len(b.encode("go", 12.375, 30.125)), len(b"go 12.375 30.125\n"))
+
+
+class FakeDevice:
+    """
+    Stands in for the controller's move queue: it answers each frame like
+    Executor does and starts one queued move every time the host reads.
+    """
+
+    def __init__(self, capacity=8) -> None:
+        self.capacity = capacity
+        self.queue = []
+        self.replies = []
+        self.started = 0
+
+    def credit(self):
+        return self.capacity - len(self.queue)
+
+    def write(self, frame):
+        command, values = b.decode(frame)
+        if command == "stream":
+            accepted = True
+        else:
+            accepted = len(self.queue) < self.capacity
+            if accepted:
+                self.queue.append(values)
+        self.replies.append(b.encode("ok" if accepted else "no", self.credit()))
+
+    def read_until(self, _):
+        if not self.replies and self.queue:
+            self.queue.pop(0)
+            self.started += 1
+            self.replies.append(b.encode("credit", self.credit()))
+        return self.replies.pop(0)
+
+
+class TestCreditStreamer(unittest.TestCase):
+    def test_never_overruns(self):
+        device = FakeDevice()
+        streamer = b.CreditStreamer(device)
+        streamer.start()
+        for i in range(100):
+            streamer.send(b.encode("gostep", i, -i))
+            self.assertLessEqual(len(device.queue), device.capacity)
+        streamer.finish()
+        self.assertEqual(streamer.rejected, 0)
+        self.assertEqual(device.started + len(device.queue), 100)
+
+
+if __name__ == "__main__":
+    unittest.main(verbosity=2)
@@ -0,0 +1,173 @@
+"""
+Generates eclipse/WorkspaceTable.h: the total string lengths over a grid of
+the workspace, stored in flash so the Arduino can look them up with bilinear
+interpolation instead of running the trig chain in Lengths.cpp.
+
+The rig constants are read from eclipse/Rig.h, so rerun this after
+changing them, naming the rig if it isn't the default:
+
+    python workspace_table.py [rig]
+"""
+import math
+import re
+import sys
+from pathlib import Path
+
+ECLIPSE = Path(__file__).resolve().parent.parent / "eclipse"
+
+# Grid spacing in inches. Halving it quarters the interpolation error but
+# quadruples the flash used.
+SPACING = 1.5
+
+# Lengths are stored as unsigned 16-bit fixed point in units of 1/UNITS inch.
+UNITS = 512
+
+# Each cell's error is checked on a SAMPLES x SAMPLES grid inside it.
+SAMPLES = 8
+
+
+def read_constants(rig=None):
+    """
+    Pull the constexpr doubles for one rig out of Rig.h: the one named, or
+    else the default build.
+    """
+    text = (ECLIPSE / "Rig.h").read_text()
+    if rig is None:
+        rig = re.search(r"#define RIG (\w+)", text).group(1)
+    body = re.search(r"struct " + rig + r" \{(.+?)\n\};", text, re.S).group(1)
+    constants = {"name": rig}
+    for name, value in re.findall(r"static constexpr double (\w+) \{(.+?)\};", body):
+        constants[name] = float(value)
+    constants["radius"] = constants["inchPerRotation"] / (2 * math.pi)
+    return constants
+
+
+class Rig:
+    """
+    Mirror of the Radial -> Tangential -> TotalLengths chain in Lengths.cpp.
+    """
+
+    def __init__(self, constants) -> None:
+        self.name = constants["name"]
+        self.width = constants["width"]
+        self.radius = constants["radius"]
+        self.min_height = constants["minHeight"]
+        self.height = constants["height"]
+
+    def total_lengths(self, x, y):
+        """
+        returns (left, right) string lengths in inches, including the arc
+        wrapped on each spool, for a true position (x, y).
+        """
+        lengths = []
+        for horizontal in (x, self.width - x):
+            radial = math.hypot(horizontal, y)
+            tangential = math.sqrt(radial ** 2 - self.radius ** 2)
+            vertical = math.atan(horizontal / y)
+            tangent_radial = math.acos(self.radius / radial)
+            offset = math.pi / 2 - (tangent_radial - vertical)
+            lengths.append(tangential + offset * self.radius)
+        return lengths
+
+
+def build(rig: Rig):
+    columns = math.ceil(rig.width / SPACING) + 1
+    rows = math.ceil((rig.height - rig.min_height) / SPACING) + 1
+
+    def node(column, row):
+        return (column * SPACING, rig.min_height + row * SPACING)
+
+    # Quantize first so the reported error includes the rounding.
+    table = [[[round(length * UNITS) for length in rig.total_lengths(*node(c, r))]
+              for c in range(columns)] for r in range(rows)]
+
+    errors = []
+    for r in range(rows - 1):
+        for c in range(columns - 1):
+            worst = 0
+            x0, y0 = node(c, r)
+            for i in range(SAMPLES + 1):
+                for j in range(SAMPLES + 1):
+                    fx, fy = i / SAMPLES, j / SAMPLES
+                    exact = rig.total_lengths(x0 + fx * SPACING, y0 + fy * SPACING)
+                    for string in range(2):
+                        top = table[r][c][string] * (1 - fx) + table[r][c + 1][string] * fx
+                        bottom = table[r + 1][c][string] * (1 - fx) + table[r + 1][c + 1][string] * fx
+                        interpolated = (top * (1 - fy) + bottom * fy) / UNITS
+                        worst = max(worst, abs(interpolated - exact[string]))
+            errors.append(worst)
+
+    return columns, rows, table, errors
+
+
+def write_header(columns, rows, table, errors, rig: Rig):
+    if max(max(max(pair) for pair in row) for row in table) > 0xFFFF:
+        raise ValueError("Lengths overflow 16 bits; lower UNITS")
+
+    # Per-cell error in table units, saturating at a byte.
+    cell_errors = [min(255, math.ceil(error * UNITS)) for error in errors]
+
+    lines = [
+        f"// Generated by py/workspace_table.py for the {rig.name} rig in Rig.h; do not edit.",
+        "#ifndef WorkspaceTable_h",
+        "#define WorkspaceTable_h",
+        "",
+        "#include <Arduino.h>",
+        "#include <avr/pgmspace.h>",
+        "",
+        "namespace WorkspaceTable {",
+        "// The rig the table was made for, checked against the one being built",
+        f"constexpr double rigWidth {{{rig.width}}};",
+        f"constexpr double rigRadius {{{rig.radius!r}}};",
+        "",
+        f"constexpr double spacing {{{SPACING}}};  // inches between nodes",
+        f"constexpr double xStart {{0}};",
+        f"constexpr double yStart {{{rig.min_height}}};",
+        f"constexpr int columns {{{columns}}};",
+        f"constexpr int rows {{{rows}}};",
+        f"constexpr double unitsPerInch {{{UNITS}}};",
+        "",
+        f"// Worst interpolation error over the table: {max(errors):.5f} in",
+        f"constexpr double maxError {{{max(errors):.5f}}};",
+        "",
+        "// Total lengths (left, right) at each node, row by row from the top",
+        "const uint16_t lengths[rows * columns][2] PROGMEM {",
+    ]
+    for row in table:
+        lines.append("    " + " ".join(f"{{{left}, {right}}}," for left, right in row))
+    lines += [
+        "};",
+        "",
+        "// Worst interpolation error inside each cell, in the same units",
+        "const uint8_t cellErrors[(rows - 1) * (columns - 1)] PROGMEM {",
+    ]
+    width = columns - 1
+    for start in range(0, len(cell_errors), width):
+        lines.append("    " + " ".join(f"{error}," for error in cell_errors[start:start + width]))
+    lines += [
+        "};",
+        "}",
+        "",
+        "#endif",
+        "",
+    ]
+    (ECLIPSE / "WorkspaceTable.h").write_text("\n".join(lines))
+
+
+def main():
+    rig = Rig(read_constants(sys.argv[1] if len(sys.argv) > 1 else None))
+    columns, rows, table, errors = build(rig)
+    write_header(columns, rows, table, errors, rig)
+
+    flash = rows * columns * 4 + len(errors)
+    print(f"{columns} x {rows} nodes, {flash} bytes of flash")
+    print(f"Interpolation error: worst {max(errors):.5f} in, median {sorted(errors)[len(errors) // 2]:.5f} in")
+
+    # Per-row worst, since the error is largest close to the motors.
+    for r in range(rows - 1):
+        row = errors[r * (columns - 1):(r + 1) * (columns - 1)]
+        print(f"  y = {rig.min_height + r * SPACING:5.1f}: worst {max(row):.5f} in")
+
+
+if __name__ == "__main__":
+    main()